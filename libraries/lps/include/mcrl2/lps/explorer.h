@@ -25,7 +25,9 @@
 #include "mcrl2/data/enumerator.h"
 #include "mcrl2/data/substitution_utility.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
+#include "mcrl2/lps/explorer_guard_index.h"
 #include "mcrl2/lps/explorer_options.h"
+#include "mcrl2/lps/explorer_stubborn_sets.h"
 #include "mcrl2/lps/find_representative.h"
 #include "mcrl2/lps/one_point_rule_rewrite.h"
 #include "mcrl2/lps/order_summand_variables.h"
@@ -486,6 +488,12 @@ class explorer: public abortable
     std::vector<explorer_summand> m_regular_summands;
     std::vector<explorer_summand> m_confluent_summands;
 
+    // Contains the dependencies between the regular summands if partial-order reduction is enabled.
+    std::unique_ptr<stubborn_sets> m_stubborn_sets;
+
+    // Selects the regular summands that can be enabled in a state, or is empty if it is not used.
+    std::unique_ptr<summand_guard_index> m_guard_index;
+
     volatile std::atomic<bool> m_must_abort = false;
 
     // N.B. The keys are stored in term_appl instead of data_expression_list for performance reasons.
@@ -825,6 +833,89 @@ class explorer: public abortable
       }
     }
 
+    // Calls f(k) for the positions k of the summands in regular_summands of which the condition is not trivially
+    // false in the state s. The guard index is only used if regular_summands are the regular summands of this
+    // explorer. The vector candidates is used as a buffer.
+    template <typename SummandSequence, typename F>
+    void for_each_candidate_summand(const state& s,
+                                    const SummandSequence& regular_summands,
+                                    std::vector<summand_guard_index::word_type>& candidates,
+                                    F f) const
+    {
+      if (m_guard_index && static_cast<const void*>(&regular_summands) == static_cast<const void*>(&m_regular_summands))
+      {
+        m_guard_index->for_each_candidate(s, candidates, f);
+      }
+      else
+      {
+        for (std::size_t k = 0; k < regular_summands.size(); ++k)
+        {
+          f(k);
+        }
+      }
+    }
+
+    // Generates the outgoing transitions of the summands in a stubborn set, and reports them via the callback
+    // function report_transition, which takes the summand as an additional first argument. If stuttering must be
+    // preserved and one of the selected transitions leads to a state with an index that is not larger than s_index,
+    // the index of the current state, all transitions are reported. As indices increase along the other transitions,
+    // every cycle contains a fully expanded state, such that no transition is ignored forever.
+    // It is assumed that the substitution sigma contains the assignments corresponding to the current state s.
+    template <typename SummandSequence, typename ReportTransition>
+    void generate_reduced_transitions(
+      const state& s,
+      const SummandSequence& regular_summands,
+      const SummandSequence& confluent_summands,
+      indexed_set_for_states_type& discovered,
+      const std::size_t thread_index,
+      const std::size_t s_index,
+      data::mutable_indexed_substitution<>& sigma,
+      data::rewriter& rewr,
+      data::data_expression& condition,
+      state_type& s1,
+      atermpp::term_appl<data::data_expression>& key,
+      data::enumerator_algorithm<>& enumerator,
+      data::enumerator_identifier_generator& id_generator,
+      ReportTransition report_transition
+    )
+    {
+      std::vector<std::tuple<std::size_t, lps::multi_action, state_type>> transitions;
+      std::vector<bool> enabled(regular_summands.size(), false);
+      std::vector<bool> selected;
+      std::vector<summand_guard_index::word_type> candidates;
+      for_each_candidate_summand(s, regular_summands, candidates, [&](std::size_t k)
+      {
+        generate_transitions(regular_summands[k], confluent_summands, sigma, rewr, condition, s1, key, enumerator, id_generator,
+          [&](const lps::multi_action& a, const state_type& t)
+          {
+            transitions.emplace_back(k, a, t);
+            enabled[k] = true;
+          }
+        );
+      });
+
+      m_stubborn_sets->select(enabled, selected);
+      if (m_stubborn_sets->preserve_stuttering() && selected != enabled)
+      {
+        for (const auto& [k, a, t]: transitions)
+        {
+          if (selected[k] && discovered.index(t, thread_index) <= s_index)
+          {
+            selected = enabled;
+            break;
+          }
+        }
+      }
+
+      for (const auto& [k, a, t]: transitions)
+      {
+        if (selected[k])
+        {
+          report_transition(regular_summands[k], a, t);
+        }
+      }
+    }
+
     template <typename SummandSequence>
     std::list<transition> out_edges(const state& s, 
                                     const SummandSequence& regular_summands, 
@@ -1005,6 +1096,28 @@ class explorer: public abortable
           m_regular_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy);
         }
       }
+
+      if (m_options.partial_order_reduction)
+      {
+        if (Stochastic || Timed)
+        {
+          throw mcrl2::runtime_error("Partial-order reduction is not supported for stochastic or timed specifications.");
+        }
+        if (m_options.confluence)
+        {
+          throw mcrl2::runtime_error("Partial-order reduction cannot be combined with confluence reduction.");
+        }
+        m_stubborn_sets = std::make_unique<stubborn_sets>(m_regular_summands, m_process_parameters, m_options.visible_actions);
+      }
+
+      if (m_options.guard_index)
+      {
+        m_guard_index = std::make_unique<summand_guard_index>(m_regular_summands, m_process_parameters, m_global_lpsspec.data(), m_global_rewr, m_global_sigma);
+        if (m_guard_index->empty())
+        {
+          m_guard_index.reset();
+        }
+      }
     }
 
     ~explorer() = default;
@@ -1070,6 +1183,7 @@ class explorer: public abortable
       std::vector<state> dummy;
       std::unique_ptr<todo_set> thread_todo=make_todo_set(dummy.begin(),dummy.end()); // The new states for each process are temporarily stored in this vector for each thread. 
       atermpp::term_appl<data::data_expression> key;  
+      std::vector<summand_guard_index::word_type> candidates; // Buffer for the summands that are considered in a state.
 
       if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads>1) m_exclusive_state_access.lock();
       while (number_of_active_processes>0 || !todo->empty())
@@ -1088,78 +1202,95 @@ class explorer: public abortable
             std::size_t s_index = discovered.index(current_state,thread_index);
             start_state(thread_index, current_state, s_index);
             data::add_assignments(thread_sigma, m_process_parameters, current_state);
-            for (const explorer_summand& summand: regular_summands)
-            {   
-              generate_transitions(
-                summand,
-                confluent_summands,
-                thread_sigma,
-                thread_rewr,
-                condition,
-                state_,
-                key,
-                thread_enumerator,
-                thread_id_generator,
-                [&](const lps::multi_action& a, const state_type& s1)
-                {   
-                  if constexpr (Timed)
-                  { 
-                    const data::data_expression& t = current_state[m_n];
-                    if (a.has_time() && less_equal(a.time(), t, thread_sigma, thread_rewr))
-                    {
-                      return;
-                    }
-                  } 
-                  if constexpr (Stochastic)
+            auto report_transition = [&](const explorer_summand& summand, const lps::multi_action& a, const state_type& s1)
+              {   
+                if constexpr (Timed)
+                { 
+                  const data::data_expression& t = current_state[m_n];
+                  if (a.has_time() && less_equal(a.time(), t, thread_sigma, thread_rewr))
+                  {
+                    return;
+                  }
+                } 
+                if constexpr (Stochastic)
+                { 
+                  std::list<std::size_t> s1_index;
+                  const auto& S1 = s1.states;
+                  // TODO: join duplicate targets
+                  for (const state& s1_: S1)
                   { 
-                    std::list<std::size_t> s1_index;
-                    const auto& S1 = s1.states;
-                    // TODO: join duplicate targets
-                    for (const state& s1_: S1)
+                    std::size_t k = discovered.index(s1_,thread_index);
+                    if (k >= discovered.size())
                     { 
-                      std::size_t k = discovered.index(s1_,thread_index);
-                      if (k >= discovered.size())
-                      { 
-                        thread_todo->insert(s1_);
-                        k = discovered.insert(s1_, thread_index).first;
-                        discover_state(thread_index, s1_, k);
-                      }
-                      s1_index.push_back(k);
+                      thread_todo->insert(s1_);
+                      k = discovered.insert(s1_, thread_index).first;
+                      discover_state(thread_index, s1_, k);
                     }
+                    s1_index.push_back(k);
+                  }
 
-                    examine_transition(thread_index, m_options.number_of_threads, current_state, s_index, a, s1, s1_index, summand.index);
-                  } 
-                  else 
+                  examine_transition(thread_index, m_options.number_of_threads, current_state, s_index, a, s1, s1_index, summand.index);
+                } 
+                else 
+                { 
+                  std::size_t s1_index; 
+                  if constexpr (Timed)
                   { 
-                    std::size_t s1_index; 
-                    if constexpr (Timed)
-                    { 
-                      s1_index = discovered.index(s1,thread_index);
-                      if (s1_index >= discovered.size())
-                      {   
-                        const data::data_expression& t = current_state[m_n];
-                        const data::data_expression& t1 = a.has_time() ? a.time() : t;
-                        make_timed_state(state_, s1, t1);
-                        s1_index = discovered.insert(state_, thread_index).first;
-                        discover_state(thread_index, state_, s1_index);
-                        thread_todo->insert(state_);
-                      } 
-                    }
-                    else
-                    { 
-                      std::pair<std::size_t,bool> p = discovered.insert(s1, thread_index);
-                      s1_index=p.first;
-                      if (p.second)  // Index is newly added. 
-                      {
-                        discover_state(thread_index, s1, s1_index);
-                        thread_todo->insert(s1); 
-                      }
+                    s1_index = discovered.index(s1,thread_index);
+                    if (s1_index >= discovered.size())
+                    {   
+                      const data::data_expression& t = current_state[m_n];
+                      const data::data_expression& t1 = a.has_time() ? a.time() : t;
+                      make_timed_state(state_, s1, t1);
+                      s1_index = discovered.insert(state_, thread_index).first;
+                      discover_state(thread_index, state_, s1_index);
+                      thread_todo->insert(state_);
+                    } 
+                  }
+                  else
+                  { 
+                    std::pair<std::size_t,bool> p = discovered.insert(s1, thread_index);
+                    s1_index=p.first;
+                    if (p.second)  // Index is newly added. 
+                    {
+                      discover_state(thread_index, s1, s1_index);
+                      thread_todo->insert(s1); 
                     }
-
-                    examine_transition(thread_index, m_options.number_of_threads, current_state, s_index, a, s1, s1_index, summand.index);
                   }
+
+                  examine_transition(thread_index, m_options.number_of_threads, current_state, s_index, a, s1, s1_index, summand.index);
                 }
-              );
+              };
+
+            if (m_stubborn_sets)
+            {
+              if constexpr (!Stochastic)
+              {
+                generate_reduced_transitions(current_state, regular_summands, confluent_summands, discovered, thread_index, s_index,
+                                             thread_sigma, thread_rewr, condition, state_, key, thread_enumerator, thread_id_generator, report_transition);
+              }
+            }
+            else
+            {
+              for_each_candidate_summand(current_state, regular_summands, candidates, [&](std::size_t k)
+              {
+                const explorer_summand& summand = regular_summands[k];
+                generate_transitions(
+                  summand,
+                  confluent_summands,
+                  thread_sigma,
+                  thread_rewr,
+                  condition,
+                  state_,
+                  key,
+                  thread_enumerator,
+                  thread_id_generator,
+                  [&](const lps::multi_action& a, const state_type& s1)
+                  {
+                    report_transition(summand, a, s1);
+                  }
+                );
+              });
             }
 
             if (number_of_idle_processes>0 && thread_todo->size()>1)
@@ -1376,10 +1507,11 @@ class explorer: public abortable
       data::data_expression condition;
       atermpp::term_appl<data::data_expression> key;
       state_type state;
-      for (const explorer_summand& summand: m_regular_summands)
+      std::vector<summand_guard_index::word_type> candidates;
+      for_each_candidate_summand(d0, m_regular_summands, candidates, [&](std::size_t k)
       {
         generate_transitions(
-          summand,
+          m_regular_summands[k],
           m_confluent_summands,
           sigma,
           rewr,
@@ -1393,7 +1525,7 @@ class explorer: public abortable
             result.emplace_back(lps::multi_action(a.actions(), a.time()), d1);
           }
         );
-      }
+      });
       set_process_parameter_values(process_parameter_undo, sigma);
       return result;
     }
@@ -1407,6 +1539,19 @@ class explorer: public abortable
       return generate_transitions(d0, m_global_sigma, m_global_rewr, m_global_enumerator, m_global_id_generator);
     }
 
+    /// \brief Computes the initial state, using the global substitution, rewriter, enumerator and id_generator.
+    state compute_initial_state()
+    {
+      static_assert(!Stochastic && !Timed);
+      state s0;
+      compute_state(s0, m_initial_state, m_global_sigma, m_global_rewr);
+      if (!m_confluent_summands.empty())
+      {
+        s0 = find_representative(s0, m_confluent_summands, m_global_sigma, m_global_rewr, m_global_enumerator, m_global_id_generator);
+      }
+      return s0;
+    }
+
     /// \brief Generates outgoing transitions for a given state.
     std::vector<std::pair<lps::multi_action, state>> generate_transitions(
               const data::data_expression_list& init,
@@ -0,0 +1,315 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/explorer_guard_index.h
+/// \brief An index on the values of process parameters that occur in simple
+///        equalities in the conditions of summands, used by the explorer to
+///        skip summands that are disabled without rewriting their conditions.
+
+#ifndef MCRL2_LPS_EXPLORER_GUARD_INDEX_H
+#define MCRL2_LPS_EXPLORER_GUARD_INDEX_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include "mcrl2/data/find.h"
+#include "mcrl2/data/rewriter.h"
+#include "mcrl2/data/standard.h"
+#include "mcrl2/data/substitutions/mutable_indexed_substitution.h"
+#include "mcrl2/lps/state.h"
+
+namespace mcrl2 {
+
+namespace lps {
+
+/// \brief Maps a state to the summands of which the condition is not trivially false in that state.
+/// \details A condition constrains a process parameter p to a set of values if it implies that p has one
+/// of these values by its shape. The equalities p == c, c == p and the boolean expressions p and !p are
+/// taken into account, where c is an expression without process parameters and summation variables that
+/// rewrites to a constructor term, combined with conjunctions, disjunctions and if-then-else. For every
+/// process parameter that is constrained by some summand, the index stores for every value c the set
+/// of summands that are compatible with p == c, i.e., the summands that do not constrain p, or constrain
+/// it to a set containing c. The candidate summands of a state are
+/// obtained by intersecting these sets, which are stored as bit vectors. The index is not modified
+/// after construction, so it can be used by several threads simultaneously.
+class summand_guard_index
+{
+  public:
+    using word_type = std::uint64_t;
+    static constexpr std::size_t bits_per_word = 64;
+
+  protected:
+    struct parameter_index
+    {
+      std::size_t position;                                                   // The position of the parameter in the state.
+      std::unordered_map<data::data_expression, std::vector<word_type>> compatible;  // The summands that are compatible with a value.
+      std::vector<word_type> unconstrained;                                   // The summands that do not constrain the parameter.
+    };
+
+    std::size_t m_number_of_summands = 0;
+    std::size_t m_number_of_words = 0;
+    std::vector<parameter_index> m_parameters;
+
+    static std::size_t count_trailing_zeros(word_type word)
+    {
+      assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+      std::size_t result = 0;
+      while ((word & 1) == 0)
+      {
+        word >>= 1;
+        ++result;
+      }
+      return result;
+#endif
+    }
+
+    static void set_bit(std::vector<word_type>& v, std::size_t i)
+    {
+      v[i / bits_per_word] |= word_type(1) << (i % bits_per_word);
+    }
+
+    static bool is_constructor_term(const data::data_expression& x, const std::set<data::function_symbol>& constructors)
+    {
+      if (data::is_function_symbol(x))
+      {
+        return constructors.find(atermpp::down_cast<data::function_symbol>(x)) != constructors.end();
+      }
+      if (data::is_application(x))
+      {
+        const data::application& a = atermpp::down_cast<data::application>(x);
+        if (!is_constructor_term(a.head(), constructors))
+        {
+          return false;
+        }
+        for (const data::data_expression& arg: a)
+        {
+          if (!is_constructor_term(arg, constructors))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+      return false;
+    }
+
+    using value_set = std::set<data::data_expression>;
+
+    // Returns a mapping from positions of process parameters p to sets of values V, such that x implies that p has
+    // a value in V. Only equalities between p and an expression for which constant_value succeeds, and the boolean
+    // connectives and if-then-else are taken into account.
+    template <typename ConstantValue>
+    static std::map<std::size_t, value_set> find_constraints(const data::data_expression& x,
+                                                             const std::map<data::variable, std::size_t>& position,
+                                                             ConstantValue constant_value)
+    {
+      std::map<std::size_t, value_set> result;
+      auto parameter_position = [&](const data::data_expression& y)
+      {
+        if (data::is_variable(y))
+        {
+          auto i = position.find(atermpp::down_cast<data::variable>(y));
+          if (i != position.end())
+          {
+            return i->second;
+          }
+        }
+        return position.size();
+      };
+
+      // The parameters that are constrained by both y and z, with the union of the values.
+      auto join = [&](const data::data_expression& y, const data::data_expression& z)
+      {
+        std::map<std::size_t, value_set> Y = find_constraints(y, position, constant_value);
+        std::map<std::size_t, value_set> Z = find_constraints(z, position, constant_value);
+        for (auto& [i, V]: Y)
+        {
+          auto j = Z.find(i);
+          if (j != Z.end())
+          {
+            V.insert(j->second.begin(), j->second.end());
+            result.emplace(i, std::move(V));
+          }
+        }
+      };
+
+      data::data_expression value;
+      if (data::is_equal_to_application(x))
+      {
+        const data::data_expression& left = data::binary_left(atermpp::down_cast<data::application>(x));
+        const data::data_expression& right = data::binary_right(atermpp::down_cast<data::application>(x));
+        if (parameter_position(left) < position.size() && constant_value(right, value))
+        {
+          result[parameter_position(left)].insert(value);
+        }
+        else if (parameter_position(right) < position.size() && constant_value(left, value))
+        {
+          result[parameter_position(right)].insert(value);
+        }
+      }
+      else if (parameter_position(x) < position.size())
+      {
+        result[parameter_position(x)].insert(data::sort_bool::true_());
+      }
+      else if (data::sort_bool::is_not_application(x) && parameter_position(data::sort_bool::arg(x)) < position.size())
+      {
+        result[parameter_position(data::sort_bool::arg(x))].insert(data::sort_bool::false_());
+      }
+      else if (data::sort_bool::is_and_application(x))
+      {
+        // The parameters that are constrained by one of the operands, with the intersection of the values.
+        result = find_constraints(data::binary_left(atermpp::down_cast<data::application>(x)), position, constant_value);
+        for (auto& [i, V]: find_constraints(data::binary_right(atermpp::down_cast<data::application>(x)), position, constant_value))
+        {
+          auto j = result.find(i);
+          if (j == result.end())
+          {
+            result.emplace(i, std::move(V));
+          }
+          else
+          {
+            value_set W;
+            std::set_intersection(j->second.begin(), j->second.end(), V.begin(), V.end(), std::inserter(W, W.end()));
+            j->second = std::move(W);
+          }
+        }
+      }
+      else if (data::sort_bool::is_or_application(x))
+      {
+        join(data::binary_left(atermpp::down_cast<data::application>(x)), data::binary_right(atermpp::down_cast<data::application>(x)));
+      }
+      else if (data::is_if_application(x))
+      {
+        const data::application& a = atermpp::down_cast<data::application>(x);
+        join(a[1], a[2]);
+      }
+      return result;
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param summands The summands, which must provide the fields variables and condition.
+    /// \param process_parameters The process parameters.
+    /// \param dataspec The data specification.
+    /// \param rewr A rewriter that is used to bring the constants in the conditions in normal form.
+    /// \param sigma A substitution that is applied to the constants. The explorer uses it to store
+    ///        constant expressions that have been replaced by variables.
+    template <typename SummandSequence>
+    summand_guard_index(const SummandSequence& summands,
+                        const std::vector<data::variable>& process_parameters,
+                        const data::data_specification& dataspec,
+                        data::rewriter& rewr,
+                        data::mutable_indexed_substitution<>& sigma)
+      : m_number_of_summands(summands.size()),
+        m_number_of_words((summands.size() + bits_per_word - 1) / bits_per_word)
+    {
+      std::map<data::variable, std::size_t> position;
+      for (std::size_t i = 0; i < process_parameters.size(); ++i)
+      {
+        position[process_parameters[i]] = i;
+      }
+      const std::set<data::function_symbol> constructors(dataspec.constructors().begin(), dataspec.constructors().end());
+
+      // constraints[i] contains the pairs (k, V) such that the condition of summand k implies that parameter i has a value in V.
+      std::vector<std::vector<std::pair<std::size_t, value_set>>> constraints(process_parameters.size());
+      for (std::size_t k = 0; k < summands.size(); ++k)
+      {
+        const auto& summand = summands[k];
+        std::set<data::variable> summation_variables(summand.variables.begin(), summand.variables.end());
+        auto constant_value = [&](const data::data_expression& c, data::data_expression& value)
+        {
+          for (const data::variable& v: data::find_free_variables(c))
+          {
+            if (position.find(v) != position.end() || summation_variables.find(v) != summation_variables.end())
+            {
+              return false;
+            }
+          }
+          value = rewr(c, sigma);
+          return is_constructor_term(value, constructors);
+        };
+        for (auto& [i, V]: find_constraints(summand.condition, position, constant_value))
+        {
+          constraints[i].emplace_back(k, std::move(V));
+        }
+      }
+
+      for (std::size_t i = 0; i < process_parameters.size(); ++i)
+      {
+        if (constraints[i].empty())
+        {
+          continue;
+        }
+        parameter_index index;
+        index.position = i;
+        index.unconstrained.assign(m_number_of_words, ~word_type(0));
+        for (const auto& [k, V]: constraints[i])
+        {
+          index.unconstrained[k / bits_per_word] &= ~(word_type(1) << (k % bits_per_word));
+        }
+        for (const auto& [k, V]: constraints[i])
+        {
+          for (const data::data_expression& value: V)
+          {
+            auto p = index.compatible.emplace(value, index.unconstrained);
+            set_bit(p.first->second, k);
+          }
+        }
+        mCRL2log(log::verbose) << "Using the values of parameter " << process_parameters[i] << " to select summands ("
+                               << constraints[i].size() << " of " << summands.size() << " summands are constrained)." << std::endl;
+        m_parameters.push_back(std::move(index));
+      }
+    }
+
+    /// \brief Returns true if no summand constrains a process parameter.
+    bool empty() const
+    {
+      return m_parameters.empty();
+    }
+
+    /// \brief Calls f(k) for every summand k of which the condition is not trivially false in the state s,
+    ///        in increasing order.
+    /// \param candidates A buffer that is used to store the candidates. By passing it, reallocations are avoided.
+    template <typename F>
+    void for_each_candidate(const state& s, std::vector<word_type>& candidates, F f) const
+    {
+      candidates.assign(m_number_of_words, ~word_type(0));
+      for (const parameter_index& index: m_parameters)
+      {
+        auto i = index.compatible.find(s[index.position]);
+        const std::vector<word_type>& compatible = i == index.compatible.end() ? index.unconstrained : i->second;
+        for (std::size_t w = 0; w < m_number_of_words; ++w)
+        {
+          candidates[w] &= compatible[w];
+        }
+      }
+      for (std::size_t w = 0; w < m_number_of_words; ++w)
+      {
+        for (word_type word = candidates[w]; word != 0; word &= word - 1)
+        {
+          const std::size_t k = w * bits_per_word + count_trailing_zeros(word);
+          if (k >= m_number_of_summands)
+          {
+            return;
+          }
+          f(k);
+        }
+      }
+    }
+};
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_EXPLORER_GUARD_INDEX_H
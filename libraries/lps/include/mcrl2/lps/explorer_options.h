@@ -43,6 +43,8 @@ struct explorer_options
   bool save_at_end = false;
   bool dfs_recursive = false;
   bool discard_lts_state_labels = false;
+  bool partial_order_reduction = false;
+  bool guard_index = true;  // If true, summands with a condition that is trivially false are not rewritten.
   bool rewrite_actions = true;    // If false, this option prevents rewriting actions.
                                   // Rewriting actions is only needed if they occur in the
                                   // generated lts, or in traces. 
@@ -54,6 +56,7 @@ struct explorer_options
   std::set<core::identifier_string> trace_actions;
   std::set<lps::multi_action> trace_multiactions;
   std::set<core::identifier_string> actions_internal_for_divergencies;
+  std::set<core::identifier_string> visible_actions; // Only used if partial_order_reduction is true.
   std::string confluence_action = "ctau";
 };
 
@@ -75,6 +78,8 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "detect-divergence = " << std::boolalpha << options.detect_divergence << std::endl;
   out << "detect-action = " << std::boolalpha << options.detect_action << std::endl;
   out << "discard-lts-state-labels = " << std::boolalpha << options.discard_lts_state_labels << std::endl;
+  out << "guard-index = " << std::boolalpha << options.guard_index << std::endl;
+  out << "partial-order-reduction = " << std::boolalpha << options.partial_order_reduction << std::endl;
   out << "save-error-trace = " << std::boolalpha << options.save_error_trace << std::endl;
   out << "generate-traces = " << std::boolalpha << options.generate_traces << std::endl;
   out << "suppress-progress-messages = " << std::boolalpha << options.suppress_progress_messages << std::endl;
@@ -88,6 +93,7 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "trace-actions = " << core::detail::print_set(options.trace_actions) << std::endl;
   out << "trace-multiactions = " << core::detail::print_set(options.trace_multiactions) << std::endl;
   out << "actions-internal-for-divergencies = " << core::detail::print_set(options.actions_internal_for_divergencies) << std::endl;
+  out << "visible-actions = " << core::detail::print_set(options.visible_actions) << std::endl;
   return out;
 }
 
@@ -0,0 +1,225 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/explorer_stubborn_sets.h
+/// \brief Computation of stubborn sets of LPS summands, used by the explorer
+///        for partial-order reduction.
+
+#ifndef MCRL2_LPS_EXPLORER_STUBBORN_SETS_H
+#define MCRL2_LPS_EXPLORER_STUBBORN_SETS_H
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+#include "mcrl2/lps/find.h"
+
+namespace mcrl2 {
+
+namespace lps {
+
+/// \brief Computes stubborn sets of the summands of a linear process.
+/// \details The analysis is syntactic. A summand reads the process parameters
+/// that occur in its condition, its actions and the right hand sides of its
+/// non-trivial assignments, and it writes the parameters that it assigns a
+/// different expression. Two summands are independent if neither writes a
+/// parameter that the other one reads or writes. The parameters that occur in
+/// the condition of a summand can only be changed by the summands that write
+/// them, which together form a necessary enabling set.
+///
+/// A stubborn set contains, for every enabled summand in it, all summands that
+/// depend on it, and for every disabled summand in it, a necessary enabling
+/// set. Exploring only the enabled summands of a nonempty stubborn set
+/// preserves all deadlocks. If visible actions are given, a set that contains
+/// an enabled visible summand is only used if it contains all enabled summands. Combined
+/// with the cycle proviso applied by the explorer, this also preserves the
+/// stutter-invariant properties over the visible actions.
+class stubborn_sets
+{
+  protected:
+    // m_dependent[k] contains the summands that are not independent of summand k.
+    std::vector<std::vector<std::size_t>> m_dependent;
+
+    // m_enabling[k] contains the summands that can change the truth value of the condition of summand k.
+    std::vector<std::vector<std::size_t>> m_enabling;
+
+    // m_visible[k] is true iff summand k has an action with a visible name.
+    std::vector<bool> m_visible;
+
+    bool m_preserve_stuttering;
+
+    // Returns the positions of the variables of x that are process parameters.
+    template <typename T>
+    static std::vector<bool> parameter_positions(const T& x, const std::map<data::variable, std::size_t>& position)
+    {
+      std::vector<bool> result(position.size(), false);
+      for (const data::variable& v: lps::find_free_variables(x))
+      {
+        auto i = position.find(v);
+        if (i != position.end())
+        {
+          result[i->second] = true;
+        }
+      }
+      return result;
+    }
+
+    static bool intersects(const std::vector<bool>& x, const std::vector<bool>& y)
+    {
+      for (std::size_t i = 0; i < x.size(); ++i)
+      {
+        if (x[i] && y[i])
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Adds to result the summands of the closure of seed, and returns the number of enabled summands
+    // in it. The computation is abandoned, and bound is returned, as soon as this number reaches bound
+    // or, if stuttering must be preserved, as soon as an enabled visible summand is added.
+    std::size_t closure(const std::size_t seed, const std::vector<bool>& enabled, const std::size_t bound, std::vector<bool>& result) const
+    {
+      result.assign(enabled.size(), false);
+      std::vector<std::size_t> todo = { seed };
+      result[seed] = true;
+      std::size_t number_of_enabled = 0;
+      while (!todo.empty())
+      {
+        const std::size_t k = todo.back();
+        todo.pop_back();
+        if (enabled[k] && (++number_of_enabled >= bound || (m_preserve_stuttering && m_visible[k])))
+        {
+          return bound;
+        }
+        for (std::size_t j: enabled[k] ? m_dependent[k] : m_enabling[k])
+        {
+          if (!result[j])
+          {
+            result[j] = true;
+            todo.push_back(j);
+          }
+        }
+      }
+      return number_of_enabled;
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param summands The summands, which must provide the fields condition, multi_action and next_state.
+    /// \param process_parameters The process parameters. The i-th element of next_state is the
+    ///        expression that is assigned to the i-th process parameter.
+    /// \param visible_actions The names of the visible actions. If this set is empty, only deadlocks are preserved.
+    template <typename SummandSequence>
+    stubborn_sets(const SummandSequence& summands,
+                  const std::vector<data::variable>& process_parameters,
+                  const std::set<core::identifier_string>& visible_actions)
+      : m_preserve_stuttering(!visible_actions.empty())
+    {
+      std::map<data::variable, std::size_t> position;
+      for (std::size_t i = 0; i < process_parameters.size(); ++i)
+      {
+        position[process_parameters[i]] = i;
+      }
+
+      const std::size_t N = summands.size();
+      std::vector<std::vector<bool>> reads;
+      std::vector<std::vector<bool>> writes;
+      std::vector<std::vector<bool>> guards;
+      for (const auto& summand: summands)
+      {
+        guards.push_back(parameter_positions(summand.condition, position));
+        std::vector<bool> r = guards.back();
+        std::vector<bool> action_reads = parameter_positions(summand.multi_action, position);
+        std::vector<bool> w(process_parameters.size(), false);
+        for (std::size_t i = 0; i < process_parameters.size(); ++i)
+        {
+          if (summand.next_state[i] != process_parameters[i])
+          {
+            w[i] = true;
+            std::vector<bool> assignment_reads = parameter_positions(summand.next_state[i], position);
+            std::transform(r.begin(), r.end(), assignment_reads.begin(), r.begin(), [](bool x, bool y) { return x || y; });
+          }
+        }
+        std::transform(r.begin(), r.end(), action_reads.begin(), r.begin(), [](bool x, bool y) { return x || y; });
+        reads.push_back(r);
+        writes.push_back(w);
+
+        bool visible = false;
+        for (const process::action& a: summand.multi_action.actions())
+        {
+          visible = visible || visible_actions.find(a.label().name()) != visible_actions.end();
+        }
+        m_visible.push_back(visible);
+      }
+
+      m_dependent.resize(N);
+      m_enabling.resize(N);
+      for (std::size_t k = 0; k < N; ++k)
+      {
+        for (std::size_t j = 0; j < N; ++j)
+        {
+          if (j != k && (intersects(writes[k], reads[j]) || intersects(writes[k], writes[j]) || intersects(writes[j], reads[k])))
+          {
+            m_dependent[k].push_back(j);
+          }
+          if (intersects(writes[j], guards[k]))
+          {
+            m_enabling[k].push_back(j);
+          }
+        }
+      }
+    }
+
+    /// \brief Indicates whether the explorer must apply the cycle proviso.
+    bool preserve_stuttering() const
+    {
+      return m_preserve_stuttering;
+    }
+
+    /// \brief Selects the summands that are explored in a state.
+    /// \param enabled For every summand, whether it has a transition in the state.
+    /// \param selected Is set to the enabled summands of a stubborn set with as few
+    ///        enabled summands as possible. If stuttering must be preserved, this set
+    ///        contains no visible summand, unless it contains all enabled summands.
+    void select(const std::vector<bool>& enabled, std::vector<bool>& selected) const
+    {
+      const std::size_t N = enabled.size();
+      std::size_t number_of_enabled = std::count(enabled.begin(), enabled.end(), true);
+      selected = enabled;
+      if (number_of_enabled <= 1)
+      {
+        return;
+      }
+
+      std::vector<bool> candidate;
+      std::size_t best = number_of_enabled;
+      for (std::size_t seed = 0; seed < N && best > 1; ++seed)
+      {
+        if (enabled[seed])
+        {
+          std::size_t count = closure(seed, enabled, best, candidate);
+          if (count < best)
+          {
+            best = count;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+              selected[k] = candidate[k] && enabled[k];
+            }
+          }
+        }
+      }
+    }
+};
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_EXPLORER_STUBBORN_SETS_H
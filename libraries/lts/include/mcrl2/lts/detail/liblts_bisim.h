@@ -1120,12 +1120,14 @@ class bisim_partitioner
  * \param[in/out] l The transition system that is reduced.
  * \param[in] branching If true branching bisimulation is applied, otherwise strong bisimulation.
  * \param[in] preserve_divergences Indicates whether loops of internal actions on states must be preserved. If false
- *            these are removed. If true these are preserved.  */
+ *            these are removed. If true these are preserved.
+ * \param[in] number_of_threads The number of threads used to remove tau loops in case of branching bisimulation. */
 template < class LTS_TYPE>
 void bisimulation_reduce(
   LTS_TYPE& l,
   const bool branching = false,
-  const bool preserve_divergences = false);
+  const bool preserve_divergences = false,
+  const std::size_t number_of_threads = 1);
 
 
 /** \brief Checks whether the two initial states of two lts's are strong or branching bisimilar.
@@ -1229,12 +1231,13 @@ mcrl2::state_formulas::state_formula bisim_partitioner<LTS_TYPE>::counter_formul
 template < class LTS_TYPE>
 void bisimulation_reduce(LTS_TYPE& l,
                          const bool branching /*=false */,
-                         const bool preserve_divergences /*=false */)
+                         const bool preserve_divergences /*=false */,
+                         const std::size_t number_of_threads /*=1 */)
 {
   // First, remove tau loops in case of branching bisimulation.
   if (branching)
   {
-    scc_reduce(l,preserve_divergences);
+    scc_reduce(l,preserve_divergences,number_of_threads);
   }
 
   // Secondly, apply the branching bisimulation reduction algorithm. If there are no tau's,
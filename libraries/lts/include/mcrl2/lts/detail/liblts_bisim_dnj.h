@@ -5487,9 +5487,12 @@ class bisim_partitioner_dnj
 ///                                    actions on states must be preserved.  If
 ///                                    false these are removed.  If true these
 ///                                    are preserved.
+/// \param         number_of_threads   The number of threads used to find the
+///                                    tau-SCCs.
 template <class LTS_TYPE>
 void bisimulation_reduce_dnj(LTS_TYPE& l, bool const branching = false,
-                                        bool const preserve_divergence = false)
+                                        bool const preserve_divergence = false,
+                                        std::size_t const number_of_threads = 1)
 {
     if (1 >= l.num_states())
     {
@@ -5500,7 +5503,7 @@ void bisimulation_reduce_dnj(LTS_TYPE& l, bool const branching = false,
     // Line 2.1: Find tau-SCCs and contract each of them to a single state
     if (branching)
     {
-        scc_reduce(l, preserve_divergence);
+        scc_reduce(l, preserve_divergence, number_of_threads);
     }
 
     // Now apply the branching bisimulation reduction algorithm.  If there
@@ -5530,13 +5533,16 @@ void bisimulation_reduce_dnj(LTS_TYPE& l, bool const branching = false,
 ///                                    tau loops on states.
 /// \param         generate_counter_examples  (non-functional, only in the
 ///                                    interface for historical reasons)
+/// \param         number_of_threads   The number of threads used to find the
+///                                    tau-SCCs.
 /// \returns True iff the initial states of the transition systems l1 and l2
 /// are ((divergence-preserving) branching) bisimilar.
 template <class LTS_TYPE>
 bool destructive_bisimulation_compare_dnj(LTS_TYPE& l1, LTS_TYPE& l2,
         bool const branching = false, bool const preserve_divergence = false,
         bool const generate_counter_examples = false,
-        const std::string& /*counter_example_file*/ = "", bool /*structured_output*/ = false)
+        const std::string& /*counter_example_file*/ = "", bool /*structured_output*/ = false,
+        std::size_t const number_of_threads = 1)
 {
     if (generate_counter_examples)
     {
@@ -5550,7 +5556,7 @@ bool destructive_bisimulation_compare_dnj(LTS_TYPE& l1, LTS_TYPE& l2,
     // Line 2.1: Find tau-SCCs and contract each of them to a single state
     if (branching)
     {
-        scc_partitioner<LTS_TYPE> scc_part(l1);
+        scc_partitioner<LTS_TYPE> scc_part(l1, number_of_threads);
         scc_part.replace_transition_system(preserve_divergence);
         init_l2 = scc_part.get_eq_class(init_l2);
     }                                                                           else  assert(!preserve_divergence);
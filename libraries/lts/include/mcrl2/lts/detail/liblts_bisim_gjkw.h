@@ -1840,10 +1840,14 @@ class bisim_partitioner_gjkw
  * \param         preserve_divergence Indicates whether loops of internal
  *                                    actions on states must be preserved. If
  *                                    false these are removed. If true these
- *                                    are preserved. */
+ *                                    are preserved.
+ * \param         number_of_threads   The number of threads used to remove
+ *                                    tau loops in case of branching
+ *                                    bisimulation. */
 template <class LTS_TYPE>
 void bisimulation_reduce_gjkw(LTS_TYPE& l, bool branching = false,
-                                            bool preserve_divergence = false);
+                                            bool preserve_divergence = false,
+                                            std::size_t number_of_threads = 1);
 
 /** \brief Checks whether the two initial states of two LTSs are strong or
  * branching bisimilar.
@@ -1885,12 +1889,13 @@ bool bisimulation_compare_gjkw(const LTS_TYPE& l1, const LTS_TYPE& l2,
 /// calculates the bisimulation quotient of a LTS.
 template <class LTS_TYPE>
 void bisimulation_reduce_gjkw(LTS_TYPE& l, bool const branching /* = false */,
-                                  bool const preserve_divergence /* = false */)
+                                  bool const preserve_divergence /* = false */,
+                                  std::size_t const number_of_threads /* = 1 */)
 {
   // First, remove tau loops in case of branching bisimulation.
   if (branching)
   {
-    scc_reduce(l, preserve_divergence);
+    scc_reduce(l, preserve_divergence, number_of_threads);
   }
 
   // Second, apply the branching bisimulation reduction algorithm. If there are
@@ -1917,7 +1922,8 @@ bool destructive_bisimulation_compare_gjkw(LTS_TYPE& l1, LTS_TYPE& l2,
           bool branching /* = false */, bool preserve_divergence /* = false */,
                                            bool generate_counter_examples /* = false */,
                                            const std::string& /*counter_example_file = "" */,
-                                           bool /*structured_output = false */)
+                                           bool /*structured_output = false */,
+                                           std::size_t const number_of_threads = 1)
 {
   if (generate_counter_examples)
   {
@@ -1931,7 +1937,7 @@ bool destructive_bisimulation_compare_gjkw(LTS_TYPE& l1, LTS_TYPE& l2,
   // First remove tau loops in case of branching bisimulation.
   if (branching)
   {
-    detail::scc_partitioner<LTS_TYPE> scc_part(l1);
+    detail::scc_partitioner<LTS_TYPE> scc_part(l1, number_of_threads);
     scc_part.replace_transition_system(preserve_divergence);
     init_l2 = scc_part.get_eq_class(init_l2);
   }
@@ -0,0 +1,589 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lts/detail/liblts_bisim_par.h
+///
+/// \brief A multi-threaded partitioner for strong and (divergence-preserving)
+///        branching bisimulation.
+///
+/// \details The partition is computed by signature refinement as described in
+/// S. Blom, S. Orzan. Distributed branching bisimulation reduction of state
+/// spaces. Proc. PDMC 2003. In every round the signatures of all states are
+/// computed and every block is split according to these signatures. Both steps
+/// are divided over the available threads. The signature of a state only
+/// depends on the signatures of its inert tau-successors, so states are handled
+/// per level of the tau-graph, which must be acyclic apart from self-loops.
+/// Blocks are split by first distributing the states over buckets according to
+/// the hash of their block and signature, after which every thread splits the
+/// states in its own buckets. Block numbers remain stable when a block is split,
+/// such that in the next round only the signatures of states of which the block
+/// or a successor's block has been split need to be recomputed.
+///
+/// Contrary to the O(m log n) algorithms in liblts_bisim_dnj.h and
+/// liblts_bisim_gjkw.h, the number of rounds is bounded by the number of states
+/// only, but every round is embarrassingly parallel.
+
+#ifndef MCRL2_LTS_LIBLTS_BISIM_PAR_H
+#define MCRL2_LTS_LIBLTS_BISIM_PAR_H
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include "mcrl2/lts/detail/liblts_merge.h"
+#include "mcrl2/lts/detail/liblts_scc.h"
+#include "mcrl2/utilities/hash_utility.h"
+#include "mcrl2/utilities/parallel_for.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+namespace detail
+{
+
+template <class LTS_TYPE>
+class bisim_partitioner_parallel
+{
+  public:
+    /// \brief Computes the coarsest (branching) bisimulation partition of an LTS.
+    /// \param l                   The LTS that is partitioned.
+    /// \param branching           If true branching bisimulation is used,
+    ///                            otherwise strong bisimulation.
+    /// \param preserve_divergence If true and branching is true, tau
+    ///                            self-loops are not considered to be inert.
+    /// \param number_of_threads   The number of threads that is used.
+    /// \pre If branching is true, the only tau-cycles of l are self-loops,
+    ///      and these only occur if preserve_divergence is true.
+    bisim_partitioner_parallel(LTS_TYPE& l,
+                               const bool branching,
+                               const bool preserve_divergence,
+                               const std::size_t number_of_threads)
+      : m_aut(l),
+        m_branching(branching),
+        m_preserve_divergence(preserve_divergence),
+        m_number_of_threads(std::max<std::size_t>(1, number_of_threads)),
+        m_block(l.num_states(), 0),
+        m_num_blocks(l.num_states() > 0 ? 1 : 0)
+    {
+      mCRL2log(log::verbose) << "Parallel " << (branching ? (preserve_divergence ? "divergence-preserving branching " : "branching ") : "")
+                             << "bisimulation partitioner created for " << l.num_states() << " states and "
+                             << l.num_transitions() << " transitions using " << m_number_of_threads << " threads.\n";
+      create_outgoing_transitions();
+      create_levels();
+      refine_partition_until_it_becomes_stable();
+    }
+
+    /// \brief The number of equivalence classes.
+    std::size_t num_eq_classes() const
+    {
+      return m_num_blocks;
+    }
+
+    /// \brief The equivalence class of a state.
+    std::size_t get_eq_class(const std::size_t s) const
+    {
+      assert(s < m_block.size());
+      return m_block[s];
+    }
+
+    /// \brief Checks whether two states are in the same equivalence class.
+    bool in_same_class(const std::size_t s, const std::size_t t) const
+    {
+      return get_eq_class(s) == get_eq_class(t);
+    }
+
+    /// \brief Replaces the LTS by its quotient modulo the computed partition.
+    /// \details The equivalence classes are numbered in the order of their
+    /// smallest state, such that the result does not depend on the number
+    /// of threads. The state labels of the states in a class are merged.
+    void finalize_minimized_LTS()
+    {
+      std::vector<transition> transitions;
+      transitions.reserve(m_out.size());
+      for (state_type s = 0; s < m_aut.num_states(); ++s)
+      {
+        for (std::size_t i = m_out_begin[s]; i < m_out_begin[s + 1]; ++i)
+        {
+          const label_type a = m_out[i].first;
+          const state_type t = m_out[i].second;
+          if (!is_inert(s, a, t) || (s == t && m_preserve_divergence))
+          {
+            transitions.emplace_back(m_block[s], a, m_block[t]);
+          }
+        }
+      }
+      std::sort(transitions.begin(), transitions.end());
+      transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
+
+      m_aut.clear_transitions(transitions.size());
+      for (const transition& t: transitions)
+      {
+        m_aut.add_transition(t);
+      }
+
+      if (m_aut.has_state_info())
+      {
+        std::vector<typename LTS_TYPE::state_label_t> new_labels(m_num_blocks);
+        for (std::size_t i = m_aut.num_states(); i > 0; )
+        {
+          --i;
+          new_labels[m_block[i]] = new_labels[m_block[i]] + m_aut.state_label(i);
+        }
+        m_aut.set_num_states(m_num_blocks);
+        for (std::size_t i = 0; i < m_num_blocks; ++i)
+        {
+          m_aut.set_state_label(i, new_labels[i]);
+        }
+      }
+      else
+      {
+        m_aut.set_num_states(m_num_blocks);
+      }
+
+      if (m_num_blocks > 0)
+      {
+        m_aut.set_initial_state(m_block[m_aut.initial_state()]);
+      }
+    }
+
+  private:
+    typedef std::size_t state_type;
+    typedef std::size_t label_type;
+    typedef std::size_t block_type;
+
+    /// \brief A signature is a sorted vector without duplicates of pairs of a label and a block.
+    typedef std::vector<std::pair<label_type, block_type> > signature_type;
+
+    /// Below this number of states a level of the tau-graph is handled by a single thread.
+    static constexpr std::size_t parallel_threshold = 1024;
+
+    LTS_TYPE& m_aut;
+    const bool m_branching;
+    const bool m_preserve_divergence;
+    const std::size_t m_number_of_threads;
+
+    std::vector<block_type> m_block;
+    std::size_t m_num_blocks;
+
+    // The outgoing transitions of state s, as pairs of a (non-hidden) label and a target state,
+    // are stored at the positions m_out_begin[s] up to m_out_begin[s+1] of m_out.
+    std::vector<std::size_t> m_out_begin;
+    std::vector<std::pair<label_type, state_type> > m_out;
+
+    // The states ordered by their level in the tau-graph. A state at level k only has tau-transitions
+    // to itself and to states at a level lower than k. Level k consists of the states at positions
+    // m_level_begin[k] up to m_level_begin[k+1] of m_level_states.
+    std::vector<std::size_t> m_level_begin;
+    std::vector<state_type> m_level_states;
+
+    std::vector<signature_type> m_signature;
+    std::vector<std::size_t> m_hash;
+
+    // m_dirty[s] indicates that the signature of s must be recomputed as the block of s or of one of its
+    // successors has been split, and m_changed[s] that the signature of s changed in the current iteration.
+    std::vector<char> m_dirty;
+    std::vector<char> m_changed;
+
+    bool is_inert(const state_type s, const label_type a, const state_type t) const
+    {
+      return m_branching && m_aut.is_tau(a) && m_block[s] == m_block[t];
+    }
+
+    void create_outgoing_transitions()
+    {
+      const std::size_t n = m_aut.num_states();
+      m_out_begin.assign(n + 1, 0);
+      for (const transition& t: m_aut.get_transitions())
+      {
+        ++m_out_begin[t.from() + 1];
+      }
+      for (state_type s = 0; s < n; ++s)
+      {
+        m_out_begin[s + 1] += m_out_begin[s];
+      }
+      m_out.resize(m_aut.num_transitions());
+      std::vector<std::size_t> position(m_out_begin.begin(), m_out_begin.end() - 1);
+      for (const transition& t: m_aut.get_transitions())
+      {
+        m_out[position[t.from()]++] = std::make_pair(m_aut.apply_hidden_label_map(t.label()), t.to());
+      }
+    }
+
+    void create_levels()
+    {
+      const std::size_t n = m_aut.num_states();
+      std::vector<std::size_t> level(n, 0);
+      if (m_branching)
+      {
+        // Determine the levels in reverse topological order of the tau-graph without self-loops,
+        // by repeatedly removing states of which all tau-successors have been removed.
+        std::vector<std::size_t> remaining_successors(n, 0);
+        std::vector<std::size_t> predecessors_begin(n + 1, 0);
+        for (state_type s = 0; s < n; ++s)
+        {
+          for (std::size_t i = m_out_begin[s]; i < m_out_begin[s + 1]; ++i)
+          {
+            if (m_aut.is_tau(m_out[i].first) && m_out[i].second != s)
+            {
+              ++remaining_successors[s];
+              ++predecessors_begin[m_out[i].second + 1];
+            }
+          }
+        }
+        for (state_type s = 0; s < n; ++s)
+        {
+          predecessors_begin[s + 1] += predecessors_begin[s];
+        }
+        std::vector<state_type> predecessors(predecessors_begin[n]);
+        std::vector<std::size_t> position(predecessors_begin.begin(), predecessors_begin.end() - 1);
+        for (state_type s = 0; s < n; ++s)
+        {
+          for (std::size_t i = m_out_begin[s]; i < m_out_begin[s + 1]; ++i)
+          {
+            if (m_aut.is_tau(m_out[i].first) && m_out[i].second != s)
+            {
+              predecessors[position[m_out[i].second]++] = s;
+            }
+          }
+        }
+
+        std::vector<state_type> todo;
+        for (state_type s = 0; s < n; ++s)
+        {
+          if (remaining_successors[s] == 0)
+          {
+            todo.push_back(s);
+          }
+        }
+        std::size_t removed = 0;
+        while (!todo.empty())
+        {
+          const state_type s = todo.back();
+          todo.pop_back();
+          ++removed;
+          for (std::size_t i = predecessors_begin[s]; i < predecessors_begin[s + 1]; ++i)
+          {
+            const state_type p = predecessors[i];
+            level[p] = std::max(level[p], level[s] + 1);
+            if (--remaining_successors[p] == 0)
+            {
+              todo.push_back(p);
+            }
+          }
+        }
+        if (removed != n)
+        {
+          throw mcrl2::runtime_error("The parallel branching bisimulation partitioner requires an LTS without tau-cycles.");
+        }
+      }
+
+      const std::size_t num_levels = n == 0 ? 0 : *std::max_element(level.begin(), level.end()) + 1;
+      m_level_begin.assign(num_levels + 1, 0);
+      for (state_type s = 0; s < n; ++s)
+      {
+        ++m_level_begin[level[s] + 1];
+      }
+      for (std::size_t k = 0; k < num_levels; ++k)
+      {
+        m_level_begin[k + 1] += m_level_begin[k];
+      }
+      m_level_states.resize(n);
+      std::vector<std::size_t> position(m_level_begin.begin(), m_level_begin.end() - 1);
+      for (state_type s = 0; s < n; ++s)
+      {
+        m_level_states[position[level[s]]++] = s;
+      }
+    }
+
+    // The signature of s consists of the pairs (a, B) for each non-inert transition from s with
+    // label a to a state in block B, together with the signatures of its inert tau-successors.
+    // The signature is only recomputed if the block of s or of one of its successors has been
+    // split, or if the signature of one of its inert tau-successors has changed.
+    void compute_signature(const state_type s)
+    {
+      bool recompute = m_dirty[s] != 0;
+      for (std::size_t i = m_out_begin[s]; !recompute && i < m_out_begin[s + 1]; ++i)
+      {
+        const state_type t = m_out[i].second;
+        recompute = t != s && m_changed[t] != 0 && is_inert(s, m_out[i].first, t);
+      }
+      if (!recompute)
+      {
+        m_changed[s] = 0;
+        return;
+      }
+
+      signature_type signature;
+      for (std::size_t i = m_out_begin[s]; i < m_out_begin[s + 1]; ++i)
+      {
+        const label_type a = m_out[i].first;
+        const state_type t = m_out[i].second;
+        if (!is_inert(s, a, t))
+        {
+          signature.emplace_back(a, m_block[t]);
+        }
+        else if (s == t)
+        {
+          if (m_preserve_divergence)
+          {
+            signature.emplace_back(a, m_block[t]);
+          }
+        }
+        else
+        {
+          signature.insert(signature.end(), m_signature[t].begin(), m_signature[t].end());
+        }
+      }
+      std::sort(signature.begin(), signature.end());
+      signature.erase(std::unique(signature.begin(), signature.end()), signature.end());
+
+      if (signature == m_signature[s])
+      {
+        m_changed[s] = 0;
+        return;
+      }
+      std::size_t hash = 0;
+      for (const std::pair<label_type, block_type>& p: signature)
+      {
+        hash = utilities::detail::hash_combine(hash, utilities::detail::hash_combine(p.first, p.second));
+      }
+      m_signature[s].swap(signature);
+      m_hash[s] = hash;
+      m_changed[s] = 1;
+    }
+
+    // Splits the blocks that contain a state of which the signature has changed. One part of a
+    // split block keeps the number of that block, and the others obtain fresh numbers. The blocks
+    // that are split or new are marked in changed_block. Returns true iff some block was split.
+    bool split_blocks(std::vector<char>& changed_block)
+    {
+      const std::size_t n = m_aut.num_states();
+      std::vector<char> affected(m_num_blocks, 0);
+      for (state_type s = 0; s < n; ++s)
+      {
+        if (m_changed[s] != 0)
+        {
+          affected[m_block[s]] = 1;
+        }
+      }
+
+      const std::size_t num_buckets = m_number_of_threads == 1 ? 1 : 4 * m_number_of_threads;
+      std::vector<std::vector<state_type> > buckets(num_buckets);
+      std::vector<state_type> affected_states;
+      for (state_type s = 0; s < n; ++s)
+      {
+        if (affected[m_block[s]] != 0)
+        {
+          affected_states.push_back(s);
+          buckets[utilities::detail::hash_combine(m_hash[s], m_block[s]) % num_buckets].push_back(s);
+        }
+      }
+
+      // Two states remain in the same block iff they were in the same block and have the same signature.
+      // Such states are always in the same bucket, so each bucket can be split independently.
+      struct state_hash
+      {
+        const std::vector<std::size_t>& hash;
+        const std::vector<block_type>& block;
+        std::size_t operator()(const state_type s) const { return utilities::detail::hash_combine(hash[s], block[s]); }
+      };
+      struct state_equal
+      {
+        const std::vector<block_type>& block;
+        const std::vector<signature_type>& signature;
+        bool operator()(const state_type s, const state_type t) const
+        {
+          return block[s] == block[t] && signature[s] == signature[t];
+        }
+      };
+
+      std::vector<std::size_t> part(n);
+      std::vector<std::size_t> bucket_size(num_buckets, 0);
+      utilities::parallel_for(num_buckets, m_number_of_threads, [&](std::size_t first, std::size_t last)
+        {
+          for (std::size_t b = first; b < last; ++b)
+          {
+            std::unordered_map<state_type, std::size_t, state_hash, state_equal>
+                representative(buckets[b].size(), state_hash{m_hash, m_block}, state_equal{m_block, m_signature});
+            for (const state_type s: buckets[b])
+            {
+              part[s] = representative.emplace(s, representative.size()).first->second;
+            }
+            bucket_size[b] = representative.size();
+          }
+        });
+      std::vector<std::size_t> bucket_offset(num_buckets + 1, 0);
+      for (std::size_t b = 0; b < num_buckets; ++b)
+      {
+        bucket_offset[b + 1] = bucket_offset[b] + bucket_size[b];
+        for (const state_type s: buckets[b])
+        {
+          part[s] += bucket_offset[b];
+        }
+      }
+
+      // The parts are numbered in the order of their smallest state, such that the numbering does
+      // not depend on the number of buckets.
+      const block_type undefined = std::numeric_limits<block_type>::max();
+      std::vector<block_type> number(bucket_offset[num_buckets], undefined);
+      std::vector<char> claimed(m_num_blocks, 0);
+      bool split = false;
+      changed_block.assign(m_num_blocks, 0);
+      for (const state_type s: affected_states)
+      {
+        block_type& b = number[part[s]];
+        if (b == undefined)
+        {
+          if (claimed[m_block[s]] == 0)
+          {
+            claimed[m_block[s]] = 1;
+            b = m_block[s];
+          }
+          else
+          {
+            split = true;
+            changed_block[m_block[s]] = 1;
+            changed_block.push_back(1);
+            b = m_num_blocks++;
+          }
+        }
+      }
+      for (const state_type s: affected_states)
+      {
+        m_block[s] = number[part[s]];
+      }
+      return split;
+    }
+
+    void refine_partition_until_it_becomes_stable()
+    {
+      const std::size_t n = m_aut.num_states();
+      m_signature.resize(n);
+      m_hash.assign(n, 0);
+      m_dirty.assign(n, 1);
+      m_changed.assign(n, 0);
+      std::vector<char> changed_block;
+      std::size_t iterations = 0;
+      bool split;
+      do
+      {
+        mCRL2log(log::debug) << "Iteration " << iterations << " starts with " << m_num_blocks << " blocks.\n";
+        for (std::size_t k = 0; k + 1 < m_level_begin.size(); ++k)
+        {
+          const std::size_t level_size = m_level_begin[k + 1] - m_level_begin[k];
+          utilities::parallel_for(level_size, level_size < parallel_threshold ? 1 : m_number_of_threads,
+            [&](std::size_t first, std::size_t last)
+            {
+              for (std::size_t i = first; i < last; ++i)
+              {
+                compute_signature(m_level_states[m_level_begin[k] + i]);
+              }
+            });
+        }
+
+        split = split_blocks(changed_block);
+        if (split)
+        {
+          // A signature can only change if the block of the state itself or of one of its successors has been split.
+          utilities::parallel_for(n, m_number_of_threads, [&](std::size_t first, std::size_t last)
+            {
+              for (state_type s = first; s < last; ++s)
+              {
+                bool dirty = changed_block[m_block[s]] != 0;
+                for (std::size_t i = m_out_begin[s]; !dirty && i < m_out_begin[s + 1]; ++i)
+                {
+                  dirty = changed_block[m_block[m_out[i].second]] != 0;
+                }
+                m_dirty[s] = dirty;
+              }
+            });
+        }
+        ++iterations;
+      }
+      while (split);
+      mCRL2log(log::verbose) << "The partition is stable after " << iterations << " iterations with " << m_num_blocks << " blocks.\n";
+
+      // Number the blocks in the order of their smallest state.
+      std::vector<block_type> number(m_num_blocks, m_num_blocks);
+      std::size_t next = 0;
+      for (state_type s = 0; s < n; ++s)
+      {
+        if (number[m_block[s]] == m_num_blocks)
+        {
+          number[m_block[s]] = next++;
+        }
+        m_block[s] = number[m_block[s]];
+      }
+      std::vector<signature_type>().swap(m_signature);
+      std::vector<std::size_t>().swap(m_hash);
+      std::vector<char>().swap(m_dirty);
+      std::vector<char>().swap(m_changed);
+    }
+};
+
+
+/// \brief Reduces transition system l with respect to strong or
+///        (divergence-preserving) branching bisimulation using multiple threads.
+/// \param[in,out] l                   The transition system that is reduced.
+/// \param         branching           If true branching bisimulation is
+///                                    applied, otherwise strong bisimulation.
+/// \param         preserve_divergence Indicates whether loops of internal
+///                                    actions on states must be preserved.
+/// \param         number_of_threads   The number of threads that is used.
+template <class LTS_TYPE>
+void bisimulation_reduce_par(LTS_TYPE& l,
+                             const bool branching = false,
+                             const bool preserve_divergence = false,
+                             const std::size_t number_of_threads = 1)
+{
+  if (branching)
+  {
+    scc_reduce(l, preserve_divergence, number_of_threads);
+  }
+  bisim_partitioner_parallel<LTS_TYPE> bisim_part(l, branching, preserve_divergence, number_of_threads);
+  bisim_part.finalize_minimized_LTS();
+}
+
+/// \brief Checks whether the initial states of two LTSs are strong or
+///        (divergence-preserving) branching bisimilar using multiple threads.
+/// \details The LTSs l1 and l2 are not usable anymore after this call.
+/// \param[in,out] l1                  A first transition system.
+/// \param[in,out] l2                  A second transition system.
+/// \param         branching           If true branching bisimulation is used,
+///                                    otherwise strong bisimulation.
+/// \param         preserve_divergence If true and branching is true, preserve
+///                                    tau loops on states.
+/// \param         number_of_threads   The number of threads that is used.
+/// \returns True iff the initial states of l1 and l2 are bisimilar.
+template <class LTS_TYPE>
+bool destructive_bisimulation_compare_par(LTS_TYPE& l1,
+                                          LTS_TYPE& l2,
+                                          const bool branching = false,
+                                          const bool preserve_divergence = false,
+                                          const std::size_t number_of_threads = 1)
+{
+  std::size_t init_l2 = l2.initial_state() + l1.num_states();
+  detail::merge(l1, std::move(l2));
+  l2.clear(); // No use for l2 anymore.
+
+  if (branching)
+  {
+    scc_partitioner<LTS_TYPE> scc_part(l1, number_of_threads);
+    scc_part.replace_transition_system(preserve_divergence);
+    init_l2 = scc_part.get_eq_class(init_l2);
+  }
+
+  bisim_partitioner_parallel<LTS_TYPE> bisim_part(l1, branching, preserve_divergence, number_of_threads);
+  return bisim_part.in_same_class(l1.initial_state(), init_l2);
+}
+
+} // namespace detail
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_LIBLTS_BISIM_PAR_H
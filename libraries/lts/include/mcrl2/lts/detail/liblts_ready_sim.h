@@ -26,7 +26,8 @@ template <class LTS_TYPE>
   class ready_sim_partitioner : public sim_partitioner<LTS_TYPE>
 {
  public:
-  ready_sim_partitioner(LTS_TYPE& l) : sim_partitioner<LTS_TYPE>(l)
+  ready_sim_partitioner(LTS_TYPE& l, std::size_t number_of_threads = 1)
+    : sim_partitioner<LTS_TYPE>(l, number_of_threads)
   {
     exists2 = new hash_table2(1000);
     forall2 = new hash_table2(1000);
@@ -256,8 +257,8 @@ void ready_sim_partitioner<LTS_TYPE>::updatei()
       if (exists2->find(beta,l)) 
         {
           for (alpha = 0; alpha < s_Pi; ++alpha)
-          if (Q[alpha][beta] && !forall2->find(alpha,l))
-            Q[alpha][beta] = false ;
+          if (Q.get(alpha,beta) && !forall2->find(alpha,l))
+            Q.reset(alpha,beta);
         }
     }
   };
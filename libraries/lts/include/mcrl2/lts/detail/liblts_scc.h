@@ -10,9 +10,12 @@
 
 #ifndef _LIBLTS_SCC_H
 #define _LIBLTS_SCC_H
+#include <atomic>
+#include <limits>
 #include <unordered_set>
 #include "mcrl2/lts/lts.h"
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/parallel_for.h"
 
 namespace mcrl2
 {
@@ -140,8 +143,17 @@ class scc_partitioner
      *  When applying the function \ref replace_transition_system the
      *  automaton l is replaced by (aka shrinked to) the automaton modulo the
      *  calculated partition.
-     *  \param[in] l reference to an LTS. */
-    scc_partitioner(LTS_TYPE& l);
+     *
+     *  If more than one thread is used, the partition is calculated by
+     *  first trimming the states that have no incoming or no outgoing
+     *  internal transitions, and subsequently applying the coloring
+     *  algorithm of S. Orzan, On distributed verification and verified
+     *  distribution, PhD thesis, 2004, to the remaining states. The
+     *  equivalence classes are then numbered in the order of their
+     *  smallest state, which may differ from the sequential numbering.
+     *  \param[in] l reference to an LTS.
+     *  \param[in] number_of_threads The number of threads used to calculate the partition. */
+    scc_partitioner(LTS_TYPE& l, std::size_t number_of_threads = 1);
 
     /** \brief Destroys this partitioner. */
     ~scc_partitioner()=default;
@@ -195,19 +207,30 @@ class scc_partitioner
     std::vector < state_type > dfsn2state;
     state_type equivalence_class_index;
 
+    typedef std::vector<std::atomic<state_type> > atomic_state_vector;
+    static constexpr state_type undefined = std::numeric_limits<state_type>::max();
+
     void group_components(const state_type t,
                           const state_type equivalence_class_index,
                           const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& src_tgt_src,
-                          std::vector < bool >& visited);
+                          std::vector < bool >& visited,
+                          std::vector < state_type >& todo);
     void dfs_numbering(const state_type t,
                        const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& src_tgt,
-                       std::vector < bool >& visited);
-
+                       std::vector < bool >& visited,
+                       std::vector < std::pair<state_type, std::size_t> >& todo);
+
+    void sequential_partitioning();
+    void parallel_partitioning(const std::size_t number_of_threads);
+    void trim(const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& forward,
+              const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& backward,
+              atomic_state_vector& component,
+              const std::size_t number_of_threads);
 };
 
 
 template < class LTS_TYPE>
-scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l)
+scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l, std::size_t number_of_threads)
   :aut(l),
     block_index_of_a_state(aut.num_states(),0),
     equivalence_class_index(0)
@@ -215,32 +238,15 @@ scc_partitioner<LTS_TYPE>::scc_partitioner(LTS_TYPE& l)
   mCRL2log(log::debug) << "Tau loop (SCC) partitioner created for " << l.num_states() << " states and " <<
               l.num_transitions() << " transitions" << std::endl;
 
-  dfsn2state.reserve(aut.num_states());
-
-  // Initialise the data structures used in the recursive DFS procedure.
-  std::vector<bool> visited(aut.num_states(),false); 
-  indexed_sorted_vector_for_tau_transitions<LTS_TYPE> src_tgt(aut,true); // Group the tau transitions ordered per outgoing states. 
-
-  // Number the states via a depth first search
-  for (state_type i=0; i<aut.num_states(); ++i)
+  if (number_of_threads>1)
   {
-    dfs_numbering(i,src_tgt,visited);
+    parallel_partitioning(number_of_threads);
   }
-  src_tgt.clear();
-
-  indexed_sorted_vector_for_tau_transitions<LTS_TYPE> tgt_src(aut,false);
-  for (std::vector < state_type >::reverse_iterator i=dfsn2state.rbegin();
-       i!=dfsn2state.rend(); ++i)
+  else
   {
-    if (visited[*i])  // Visited is used inversely here.
-    {
-      group_components(*i,equivalence_class_index,tgt_src,visited);
-      equivalence_class_index++;
-    }
+    sequential_partitioning();
   }
   mCRL2log(log::debug) << "Tau loop (SCC) partitioner reduces lts to " << equivalence_class_index << " states." << std::endl;
-
-  dfsn2state.clear();
 }
 
 
@@ -317,51 +323,313 @@ bool scc_partitioner<LTS_TYPE>::in_same_class(const std::size_t s, const std::si
 
 // Private methods of scc_partitioner
 
+template < class LTS_TYPE>
+void scc_partitioner<LTS_TYPE>::sequential_partitioning()
+{
+  dfsn2state.reserve(aut.num_states());
+
+  // Initialise the data structures used in the DFS procedures. The stacks are kept explicitly, such
+  // that long sequences of tau transitions cannot exhaust the call stack.
+  std::vector<bool> visited(aut.num_states(),false); 
+  indexed_sorted_vector_for_tau_transitions<LTS_TYPE> src_tgt(aut,true); // Group the tau transitions ordered per outgoing states. 
+
+  // Number the states via a depth first search
+  std::vector < std::pair<state_type, std::size_t> > dfs_todo;
+  for (state_type i=0; i<aut.num_states(); ++i)
+  {
+    dfs_numbering(i,src_tgt,visited,dfs_todo);
+  }
+  src_tgt.clear();
+
+  indexed_sorted_vector_for_tau_transitions<LTS_TYPE> tgt_src(aut,false);
+  std::vector < state_type > group_todo;
+  for (std::vector < state_type >::reverse_iterator i=dfsn2state.rbegin();
+       i!=dfsn2state.rend(); ++i)
+  {
+    if (visited[*i])  // Visited is used inversely here.
+    {
+      group_components(*i,equivalence_class_index,tgt_src,visited,group_todo);
+      equivalence_class_index++;
+    }
+  }
+
+  dfsn2state.clear();
+}
+
+template < class LTS_TYPE>
+void scc_partitioner<LTS_TYPE>::parallel_partitioning(const std::size_t number_of_threads)
+{
+  const std::size_t n=aut.num_states();
+  const indexed_sorted_vector_for_tau_transitions<LTS_TYPE> src_tgt(aut,true);
+  const indexed_sorted_vector_for_tau_transitions<LTS_TYPE> tgt_src(aut,false);
+
+  // For each state the representative of its component, or undefined if its component is not yet known.
+  // A representative of a component is always a member of the component itself.
+  // The color of a state is used to determine its component, as explained below.
+  atomic_state_vector component(n);
+  atomic_state_vector color(n);
+  utilities::parallel_for(n, number_of_threads, [&](std::size_t first, std::size_t last)
+    {
+      for (state_type s=first; s<last; ++s)
+      {
+        component[s].store(undefined, std::memory_order_relaxed);
+        color[s].store(undefined, std::memory_order_relaxed);
+      }
+    });
+
+  // Remove the states without incoming tau transitions, and then the states without outgoing
+  // tau transitions, as these form a component on their own.
+  trim(src_tgt, tgt_src, component, number_of_threads);
+  trim(tgt_src, src_tgt, component, number_of_threads);
+
+  std::vector<state_type> remaining;
+  for (state_type s=0; s<n; ++s)
+  {
+    if (component[s].load(std::memory_order_relaxed)==undefined)
+    {
+      remaining.push_back(s);
+    }
+  }
+
+  std::vector<state_type> roots;
+  while (!remaining.empty())
+  {
+    mCRL2log(log::debug) << "Coloring " << remaining.size() << " states of which the component is not yet known." << std::endl;
+
+    // Give every remaining state the largest state number from which it can be reached via
+    // remaining states. If a thread increases the color of a state it also propagates this
+    // color further, hence no synchronisation is needed until all threads are finished.
+    utilities::parallel_for(remaining.size(), number_of_threads, [&](std::size_t first, std::size_t last)
+      {
+        for (std::size_t i=first; i<last; ++i)
+        {
+          color[remaining[i]].store(remaining[i], std::memory_order_relaxed);
+        }
+      });
+    utilities::parallel_for(remaining.size(), number_of_threads, [&](std::size_t first, std::size_t last)
+      {
+        std::vector<state_type> todo(remaining.begin()+first, remaining.begin()+last);
+        while (!todo.empty())
+        {
+          const state_type s=todo.back();
+          todo.pop_back();
+          const state_type c=color[s].load(std::memory_order_relaxed);
+          const std::size_t u=src_tgt.upperbound(s);
+          for (std::size_t i=src_tgt.lowerbound(s); i<u; ++i)
+          {
+            const state_type t=src_tgt.get_transitions()[i];
+            if (component[t].load(std::memory_order_relaxed)!=undefined)
+            {
+              continue;
+            }
+            state_type old_color=color[t].load(std::memory_order_relaxed);
+            while (old_color<c && !color[t].compare_exchange_weak(old_color, c, std::memory_order_relaxed))
+            {
+            }
+            if (old_color<c)
+            {
+              todo.push_back(t);
+            }
+          }
+        }
+      });
+
+    // A state that keeps its own color is the largest state of its component. This component
+    // consists of the states with the same color from which it can be reached. As the colors
+    // are disjoint, the components can be gathered in parallel.
+    roots.clear();
+    for (const state_type s: remaining)
+    {
+      if (color[s].load(std::memory_order_relaxed)==s)
+      {
+        roots.push_back(s);
+      }
+    }
+    utilities::parallel_for(roots.size(), number_of_threads, [&](std::size_t first, std::size_t last)
+      {
+        std::vector<state_type> todo;
+        for (std::size_t i=first; i<last; ++i)
+        {
+          const state_type root=roots[i];
+          component[root].store(root, std::memory_order_relaxed);
+          todo.push_back(root);
+          while (!todo.empty())
+          {
+            const state_type s=todo.back();
+            todo.pop_back();
+            const std::size_t u=tgt_src.upperbound(s);
+            for (std::size_t j=tgt_src.lowerbound(s); j<u; ++j)
+            {
+              const state_type t=tgt_src.get_transitions()[j];
+              if (color[t].load(std::memory_order_relaxed)==root &&
+                  component[t].load(std::memory_order_relaxed)==undefined)
+              {
+                component[t].store(root, std::memory_order_relaxed);
+                todo.push_back(t);
+              }
+            }
+          }
+        }
+      });
+
+    remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                   [&](const state_type s){ return component[s].load(std::memory_order_relaxed)!=undefined; }),
+                    remaining.end());
+  }
+
+  // Number the components in the order of their smallest state. The vector color is reused to
+  // store the equivalence class of each representative.
+  for (state_type s=0; s<n; ++s)
+  {
+    color[s].store(undefined, std::memory_order_relaxed);
+  }
+  for (state_type s=0; s<n; ++s)
+  {
+    const state_type representative=component[s].load(std::memory_order_relaxed);
+    if (color[representative].load(std::memory_order_relaxed)==undefined)
+    {
+      color[representative].store(equivalence_class_index++, std::memory_order_relaxed);
+    }
+    block_index_of_a_state[s]=color[representative].load(std::memory_order_relaxed);
+  }
+}
+
+// Repeatedly removes the states of which the component is not yet known and that have no transitions
+// in backward from such states. Each removed state forms a component on its own. Each thread starts
+// with its own part of the states, and the thread that removes the last such transition of a state
+// also removes that state.
+template < class LTS_TYPE>
+void scc_partitioner<LTS_TYPE>::trim(
+  const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& forward,
+  const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& backward,
+  atomic_state_vector& component,
+  const std::size_t number_of_threads)
+{
+  const std::size_t n=aut.num_states();
+  atomic_state_vector degree(n);
+  utilities::parallel_for(n, number_of_threads, [&](std::size_t first, std::size_t last)
+    {
+      for (state_type s=first; s<last; ++s)
+      {
+        std::size_t d=0;
+        const std::size_t u=backward.upperbound(s);
+        for (std::size_t i=backward.lowerbound(s); i<u; ++i)
+        {
+          if (component[backward.get_transitions()[i]].load(std::memory_order_relaxed)==undefined)
+          {
+            ++d;
+          }
+        }
+        degree[s].store(d, std::memory_order_relaxed);
+      }
+    });
+
+  utilities::parallel_for(n, number_of_threads, [&](std::size_t first, std::size_t last)
+    {
+      std::vector<state_type> todo;
+      for (state_type s=first; s<last; ++s)
+      {
+        if (degree[s].load(std::memory_order_relaxed)==0 &&
+            component[s].load(std::memory_order_relaxed)==undefined)
+        {
+          todo.push_back(s);
+        }
+      }
+      while (!todo.empty())
+      {
+        const state_type s=todo.back();
+        todo.pop_back();
+        component[s].store(s, std::memory_order_relaxed);
+        const std::size_t u=forward.upperbound(s);
+        for (std::size_t i=forward.lowerbound(s); i<u; ++i)
+        {
+          const state_type t=forward.get_transitions()[i];
+          // The component of t cannot change concurrently, as t is only removed after this transition.
+          if (component[t].load(std::memory_order_relaxed)==undefined &&
+              degree[t].fetch_sub(1, std::memory_order_relaxed)==1)
+          {
+            todo.push_back(t);
+          }
+        }
+      }
+    });
+}
+
 template < class LTS_TYPE>
 void scc_partitioner<LTS_TYPE>::group_components(
   const state_type s,
   const state_type equivalence_class_index,
   const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& tgt_src,
-  std::vector < bool >& visited)
+  std::vector < bool >& visited,
+  std::vector < state_type >& todo)
 {
   if (!visited[s])
   {
     return;
   }
   visited[s] = false;
-  const size_t u=tgt_src.upperbound(s);  // only calculate the upperbound once. 
-  for(state_type i=tgt_src.lowerbound(s); i<u; ++i)
+  todo.push_back(s);
+  while (!todo.empty())
   {
-    group_components(tgt_src.get_transitions()[i],equivalence_class_index,tgt_src,visited);
+    const state_type t=todo.back();
+    todo.pop_back();
+    const size_t u=tgt_src.upperbound(t);  // only calculate the upperbound once. 
+    for(state_type i=tgt_src.lowerbound(t); i<u; ++i)
+    {
+      const state_type v=tgt_src.get_transitions()[i];
+      if (visited[v])
+      {
+        visited[v] = false;
+        todo.push_back(v);
+      }
+    }
+    block_index_of_a_state[t]=equivalence_class_index;
   }
-  block_index_of_a_state[s]=equivalence_class_index;
 }
 
 template < class LTS_TYPE>
 void scc_partitioner<LTS_TYPE>::dfs_numbering(
   const state_type s,
   const indexed_sorted_vector_for_tau_transitions<LTS_TYPE>& src_tgt,
-  std::vector < bool >& visited)
+  std::vector < bool >& visited,
+  std::vector < std::pair<state_type, std::size_t> >& todo)
 {
   if (visited[s])
   {
     return;
   }
   visited[s] = true;
-  const size_t u=src_tgt.upperbound(s);  // only calculate the upperbound once. 
-  for(state_type i=src_tgt.lowerbound(s); i<u; ++i)
+  // Each entry on the stack contains a state and the index of its next outgoing tau transition
+  // that must be explored. A state is numbered when all its outgoing transitions are explored.
+  todo.emplace_back(s,src_tgt.lowerbound(s));
+  while (!todo.empty())
   {
-    dfs_numbering(src_tgt.get_transitions()[i],src_tgt,visited);
+    const state_type t=todo.back().first;
+    const std::size_t i=todo.back().second;
+    if (i<src_tgt.upperbound(t))
+    {
+      todo.back().second++;
+      const state_type v=src_tgt.get_transitions()[i];
+      if (!visited[v])
+      {
+        visited[v] = true;
+        todo.emplace_back(v,src_tgt.lowerbound(v));
+      }
+    }
+    else
+    {
+      dfsn2state.push_back(t);
+      todo.pop_back();
+    }
   }
-  dfsn2state.push_back(s);
 }
 
 } // namespace detail
 
 template < class LTS_TYPE>
-void scc_reduce(LTS_TYPE& l,const bool preserve_divergence_loops = false)
+void scc_reduce(LTS_TYPE& l,const bool preserve_divergence_loops = false, const std::size_t number_of_threads = 1)
 {
-  detail::scc_partitioner<LTS_TYPE> scc_part(l);
+  detail::scc_partitioner<LTS_TYPE> scc_part(l, number_of_threads);
   scc_part.replace_transition_system(preserve_divergence_loops);
 }
 
@@ -13,6 +13,8 @@
 #define LIBLTS_SIM_H
 #include "mcrl2/lts/lts_utilities.h"
 #include "mcrl2/lts/detail/sim_hashtable.h"
+#include "mcrl2/lts/detail/sim_bit_matrix.h"
+#include "mcrl2/utilities/parallel_for.h"
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/lts_fsm.h"
 #include "mcrl2/lts/lts_dot.h"
@@ -29,8 +31,11 @@ class sim_partitioner
 {
   public:
     /** Creates a partitioner for an LTS.
-     * \param[in] l Pointer to the LTS. */
-    sim_partitioner(LTS_TYPE& l);
+     * \param[in] l Pointer to the LTS.
+     * \param[in] number_of_threads The maximal number of threads that is
+     * used to update the relations on blocks. The result does not depend
+     * on the number of threads. */
+    sim_partitioner(LTS_TYPE& l, std::size_t number_of_threads = 1);
 
     /** Destroys this partitioner. */
     ~sim_partitioner();
@@ -97,7 +102,12 @@ class sim_partitioner
       ptrdiff_t prev;
     };
 
+    /** Relations on fewer blocks than this are always updated by a
+     * single thread, as the overhead of the threads would dominate. */
+    static constexpr std::size_t parallel_threshold = 512;
+
     LTS_TYPE& aut;
+    std::size_t m_number_of_threads;
     mcrl2::lts::outgoing_transitions_per_state_action_t trans_index;
     std::size_t s_Sigma;
     std::size_t s_Pi;
@@ -109,14 +119,14 @@ class sim_partitioner
     std::vector< std::vector<std::size_t> > children;
     std::vector<ptrdiff_t> contents_t;
     std::vector<ptrdiff_t> contents_u;
-    std::vector< std::vector<bool> > stable;
+    bit_matrix stable;
     hash_table3* exists;
     hash_table3* forall;
     std::vector< std::vector<std::size_t> > pre_exists;
     std::vector< std::vector<std::size_t> > pre_forall;
     hash_table3* match;
-    std::vector< std::vector<bool> > P;
-    std::vector< std::vector<bool> > Q;
+    bit_matrix P;
+    bit_matrix Q;
 
     /* auxiliary variables */
     std::vector<std::size_t> touched_blocks;
@@ -138,7 +148,8 @@ class sim_partitioner
 
     void initialise_Sigma(std::size_t gamma,std::size_t l);
     void initialise_Pi(std::size_t gamma,std::size_t l);
-    void filter(std::size_t S,std::vector< std::vector<bool> >& R,bool B);
+    void filter(std::size_t S,bit_matrix& R,bool B);
+    void filter_Q(std::size_t S,std::size_t first_word,std::size_t last_word);
     void cleanup(std::size_t alpha,std::size_t beta);
     void initialise_pre_EA();
     void induce_P_on_Pi();
@@ -147,7 +158,7 @@ class sim_partitioner
     std::string print_Pi_Q();
     std::string print_Sigma();
     std::string print_Pi();
-    std::string print_relation(std::size_t s,std::vector< std::vector<bool> >& R);
+    std::string print_relation(std::size_t s,const bit_matrix& R);
     std::string print_block(std::size_t b);
     std::string print_structure(hash_table3* struc);
     std::string print_reverse_topological_sort(const std::vector<std::size_t>& Sort);
@@ -158,8 +169,9 @@ class sim_partitioner
 #define UNIVERSAL_PART (0)
 
 template <class LTS_TYPE>
-sim_partitioner<LTS_TYPE>::sim_partitioner(LTS_TYPE& l)
-  : aut(l)
+sim_partitioner<LTS_TYPE>::sim_partitioner(LTS_TYPE& l, std::size_t number_of_threads)
+  : aut(l),
+    m_number_of_threads(number_of_threads)
 {
   match  = new hash_table3(1000);
   exists = new hash_table3(1000);
@@ -281,12 +293,11 @@ void sim_partitioner<LTS_TYPE>::initialise_datastructures()
   /* initialise P and children */
   std::vector<std::size_t> vi;
   children.assign(s_Sigma,vi);
-  std::vector<bool> vb(s_Sigma,false);
-  P.assign(s_Sigma,vb);
+  P.assign(s_Sigma,s_Sigma);
   for (std::size_t i = 0; i < s_Sigma; ++i)
   {
     children[i].push_back(i);
-    P[i][i] = true;
+    P.set(i,i);
   }
 
   mCRL2log(log::debug) << "--------------------- INITIALISATION ---------------------------" << std::endl;
@@ -383,11 +394,9 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
   }
 
   /* Some local variables */
-  std::vector<bool> v_false(s_Sigma,false);
   std::vector<std::size_t>::iterator alphai, last, gammai;
-  std::vector< std::vector<bool> >::iterator stable_alpha, P_gamma;
   bool stable_alpha_gamma;
-  std::size_t gamma, delta, l;
+  std::size_t gamma, l;
 
   /* The main loop */
   for (l = 0; l < aut.num_action_labels(); ++l)
@@ -396,7 +405,7 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
     mCRL2log(log::debug) << "Label = \"" << mcrl2::lts::pp(aut.action_label(l)) << "\"" << std::endl;
 
     /* reset the stable function */
-    stable.assign(s_Pi,v_false);
+    stable.assign(s_Pi,s_Sigma);
 
     /* iterate over the reverse topological sorting */
     for (gammai = Sort.begin(); gammai != Sort.end(); ++gammai)
@@ -411,19 +420,14 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
       for (alphai = touched_blocks.begin(); alphai != last; ++alphai)
       {
         alpha = *alphai;
-        /* compute stable(alpha,gamma); use a local boolean variable for
-         * efficiency */
-        stable_alpha_gamma = false;
-        stable_alpha = stable.begin() + alpha;
-        P_gamma = P.begin() + gamma;
-        for (delta = 0; delta < s_Sigma && !stable_alpha_gamma; ++delta)
+        /* compute stable(alpha,gamma), i.e., whether there is a delta
+         * with stable(alpha,delta) and P(gamma,delta); this is done a
+         * word of the relations at a time */
+        stable_alpha_gamma = stable.intersects(alpha,P,gamma);
+        if (stable_alpha_gamma)
         {
-          if ((*stable_alpha)[delta] && (*P_gamma)[delta])
-          {
-            stable_alpha_gamma = true;
-          }
+          stable.set(alpha,gamma);
         }
-        (*stable_alpha)[gamma] = stable_alpha_gamma;
         if (!stable_alpha_gamma)
         {
           /* if alpha -l->A gamma then alpha cannot be split */
@@ -434,7 +438,7 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
 
             children[parent[alpha]].push_back(s_Pi);
             parent.push_back(parent[alpha]);
-            stable.push_back(*stable_alpha);
+            stable.push_back_row(alpha);
             block_touched.push_back(false);
             contents_t.push_back(LIST_END);
 
@@ -450,7 +454,7 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
             }
             ++s_Pi;
           }
-          stable[alpha][gamma] = true;
+          stable.set(alpha,gamma);
         }
         untouch(alpha);
       }
@@ -476,9 +480,9 @@ void sim_partitioner<LTS_TYPE>::dfs_visit(std::size_t u,std::vector<bool>& visit
     std::vector<std::size_t> &Sort)
 {
   visited[u] = true;
-  for (std::size_t v = 0; v < s_Sigma; ++v)
+  for (std::size_t v = P.find_next(u,0); v < s_Sigma; v = P.find_next(u,v+1))
   {
-    if (!visited[v] && P[u][v])
+    if (!visited[v])
     {
       dfs_visit(v,visited,Sort);
     }
@@ -647,27 +651,31 @@ void sim_partitioner<LTS_TYPE>::initialise_pre_EA()
 template <class LTS_TYPE>
 void sim_partitioner<LTS_TYPE>::induce_P_on_Pi()
 {
-  /* Compute the relation induced on Pi by P, store it in Q */
-  std::vector<bool> v(s_Pi,false);
-  Q.assign(s_Pi,v);
-
-  std::size_t alpha,beta;
-  std::vector< std::vector<bool> >::iterator P_parent_alpha;
-  for (alpha = 0; alpha < s_Pi; ++alpha)
-  {
-    P_parent_alpha = P.begin() + parent[alpha];
-    for (beta = 0; beta < s_Pi; ++beta)
-    {
-      Q[alpha][beta] = (*P_parent_alpha)[parent[beta]];
-    }
-  }
+  /* Compute the relation induced on Pi by P, store it in Q. The rows
+   * of Q are independent, so they are divided over the threads. */
+  Q.assign(s_Pi,s_Pi);
+  utilities::parallel_for(s_Pi, s_Pi < parallel_threshold ? 1 : m_number_of_threads,
+      [this](std::size_t first_alpha, std::size_t last_alpha)
+      {
+        for (std::size_t alpha = first_alpha; alpha < last_alpha; ++alpha)
+        {
+          const std::size_t parent_alpha = parent[alpha];
+          for (std::size_t beta = 0; beta < s_Pi; ++beta)
+          {
+            if (P.get(parent_alpha,parent[beta]))
+            {
+              Q.set(alpha,beta);
+            }
+          }
+        }
+      });
 }
 
 
 /* ----------------- FILTER ----------------------------------------- */
 
 template <class LTS_TYPE>
-void sim_partitioner<LTS_TYPE>::filter(std::size_t S,std::vector< std::vector<bool> > &R,
+void sim_partitioner<LTS_TYPE>::filter(std::size_t S,bit_matrix& R,
                                        bool B)
 {
   /* Initialise the match function */
@@ -685,7 +693,7 @@ void sim_partitioner<LTS_TYPE>::filter(std::size_t S,std::vector< std::vector<bo
         beta = etrans.get_x();
         for (gamma = 0; gamma < S; ++gamma)
         {
-          if (R[gamma][delta])
+          if (R.get(gamma,delta))
           {
             match->add(l,beta,gamma);
           }
@@ -694,6 +702,20 @@ void sim_partitioner<LTS_TYPE>::filter(std::size_t S,std::vector< std::vector<bo
     }
   }
 
+  if (!B)
+  {
+    /* Without cleaning up, whether a pair is removed from Q does not
+     * depend on the removal of other pairs. The columns of Q are divided
+     * over the threads at word boundaries, such that every thread
+     * modifies its own words of Q only; match is only read. */
+    utilities::parallel_for(Q.words_per_row(), s_Pi < parallel_threshold ? 1 : m_number_of_threads,
+        [this,S](std::size_t first_word, std::size_t last_word)
+        {
+          filter_Q(S,first_word,last_word);
+        });
+    return;
+  }
+
   hash_table3_iterator atrans(forall);
   /* The main for loop */
   for (l = 0; l < aut.num_action_labels(); ++l)
@@ -704,15 +726,43 @@ void sim_partitioner<LTS_TYPE>::filter(std::size_t S,std::vector< std::vector<bo
       for (atrans.set(pre_forall[l][gamma]); !atrans.is_end(); ++atrans)
       {
         alpha = atrans.get_x();
-        for (beta = 0; beta < s_Pi; ++beta)
+        for (beta = Q.find_next(alpha,0); beta < s_Pi; beta = Q.find_next(alpha,beta+1))
         {
-          if (Q[alpha][beta] && !match->find(l,beta,gamma))
+          if (!match->find(l,beta,gamma))
           {
-            Q[alpha][beta] = false;
-            if (B)
-            {
-              cleanup(alpha,beta);
-            }
+            Q.reset(alpha,beta);
+            cleanup(alpha,beta);
+          }
+        }
+      }
+    }
+  }
+}
+
+/* Removes the pairs (alpha,beta) from Q for which alpha -l->A gamma, with
+ * gamma < S, but not match(l,beta,gamma), restricted to the columns beta in the given range of
+ * words of the rows of Q. */
+template <class LTS_TYPE>
+void sim_partitioner<LTS_TYPE>::filter_Q(std::size_t S,std::size_t first_word,std::size_t last_word)
+{
+  const std::size_t first_beta = first_word * bit_matrix::bits_per_word;
+  const std::size_t last_beta = std::min(last_word * bit_matrix::bits_per_word, s_Pi);
+  std::size_t alpha,beta,gamma,l;
+  hash_table3_iterator atrans(forall);
+  for (l = 0; l < aut.num_action_labels(); ++l)
+  {
+    for (gamma = 0; gamma < S; ++gamma)
+    {
+      atrans.set_end(pre_forall[l][gamma+1]);
+      for (atrans.set(pre_forall[l][gamma]); !atrans.is_end(); ++atrans)
+      {
+        alpha = atrans.get_x();
+        for (beta = Q.find_next(alpha,first_beta,last_beta); beta < last_beta;
+             beta = Q.find_next(alpha,beta+1,last_beta))
+        {
+          if (!match->find(l,beta,gamma))
+          {
+            Q.reset(alpha,beta);
           }
         }
       }
@@ -737,9 +787,10 @@ void sim_partitioner<LTS_TYPE>::cleanup(std::size_t alpha,std::size_t beta)
     {
       beta1 = beta1i.get_x();
       match_l_beta1_alpha = false;
-      for (delta = 0; delta < s_Pi && !match_l_beta1_alpha; ++delta)
+      for (delta = Q.find_next(alpha,0); delta < s_Pi && !match_l_beta1_alpha;
+           delta = Q.find_next(alpha,delta+1))
       {
-        if (exists->find(beta1,l,delta) && Q[alpha][delta])
+        if (exists->find(beta1,l,delta))
         {
           match_l_beta1_alpha = true;
         }
@@ -751,9 +802,9 @@ void sim_partitioner<LTS_TYPE>::cleanup(std::size_t alpha,std::size_t beta)
              ++alpha1i)
         {
           alpha1 = alpha1i.get_x();
-          if (Q[alpha1][beta1])
+          if (Q.get(alpha1,beta1))
           {
-            Q[alpha1][beta1] = false;
+            Q.reset(alpha1,beta1);
             cleanup(alpha1,beta1);
           }
         }
@@ -789,7 +840,7 @@ std::vector < mcrl2::lts::transition> sim_partitioner<LTS_TYPE>::get_transitions
       for (gamma = 0; gamma < s_Pi; ++gamma)
       {
         // only consider gammas that are unequal to beta
-        if (gamma != beta && Q[beta][gamma])
+        if (gamma != beta && Q.get(beta,gamma))
         {
           alphai.set_end(pre_exists[l][gamma+1]);
           for (alphai.set(pre_exists[l][gamma]); !alphai.is_end();
@@ -829,7 +880,7 @@ std::size_t sim_partitioner<LTS_TYPE>::get_eq_class(std::size_t s) const
 template <class LTS_TYPE>
 bool sim_partitioner<LTS_TYPE>::in_preorder(std::size_t s,std::size_t t) const
 {
-  return Q[block_Pi[s]][block_Pi[t]];
+  return Q.get(block_Pi[s],block_Pi[t]);
 }
 
 template <class LTS_TYPE>
@@ -1036,7 +1087,7 @@ std::string sim_partitioner<LTS_TYPE>::print_block(std::size_t b)
 
 template <class LTS_TYPE>
 std::string sim_partitioner<LTS_TYPE>::print_relation(std::size_t s,
-    std::vector< std::vector<bool> > &R)
+    const bit_matrix& R)
 {
   using namespace mcrl2::core;
   std::stringstream result;
@@ -1046,7 +1097,7 @@ std::string sim_partitioner<LTS_TYPE>::print_relation(std::size_t s,
   {
     for (gamma = 0; gamma < s; ++gamma)
     {
-      if (R[beta][gamma])
+      if (R.get(beta,gamma))
       {
         result << "(" << beta << "," << gamma << "),";
       }
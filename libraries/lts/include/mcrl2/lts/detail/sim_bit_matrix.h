@@ -0,0 +1,183 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file sim_bit_matrix.h
+/// \brief A compact square or rectangular boolean matrix, used to store
+///        the relations on blocks in the simulation preorder algorithm.
+
+#ifndef MCRL2_LTS_DETAIL_SIM_BIT_MATRIX_H
+#define MCRL2_LTS_DETAIL_SIM_BIT_MATRIX_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mcrl2
+{
+namespace lts
+{
+namespace detail
+{
+
+/// \brief A boolean matrix of which the rows are stored consecutively as
+///        sequences of machine words.
+/// \details Every row occupies the same number of words, such that rows can be
+///          combined word by word. Different threads can safely access different
+///          rows, or disjoint word ranges of the same row, provided that every
+///          thread only reads words in its own range, e.g., by using the bounded
+///          variant of find_next.
+class bit_matrix
+{
+  public:
+    using word_type = std::uint64_t;
+    static constexpr std::size_t bits_per_word = 64;
+
+    bit_matrix() = default;
+
+    /// \brief Makes this a matrix of the given dimensions in which all entries are false.
+    void assign(std::size_t rows, std::size_t columns)
+    {
+      m_rows = rows;
+      m_columns = columns;
+      m_words_per_row = words_for(columns);
+      m_words.assign(m_rows * m_words_per_row, 0);
+    }
+
+    std::size_t rows() const
+    {
+      return m_rows;
+    }
+
+    std::size_t columns() const
+    {
+      return m_columns;
+    }
+
+    std::size_t words_per_row() const
+    {
+      return m_words_per_row;
+    }
+
+    bool get(std::size_t row, std::size_t column) const
+    {
+      assert(row < m_rows && column < m_columns);
+      return (m_words[row * m_words_per_row + column / bits_per_word] >> (column % bits_per_word)) & 1;
+    }
+
+    void set(std::size_t row, std::size_t column)
+    {
+      assert(row < m_rows && column < m_columns);
+      m_words[row * m_words_per_row + column / bits_per_word] |= word_type(1) << (column % bits_per_word);
+    }
+
+    void reset(std::size_t row, std::size_t column)
+    {
+      assert(row < m_rows && column < m_columns);
+      m_words[row * m_words_per_row + column / bits_per_word] &= ~(word_type(1) << (column % bits_per_word));
+    }
+
+    /// \brief Appends a copy of the given row to this matrix.
+    void push_back_row(std::size_t row)
+    {
+      assert(row < m_rows);
+      m_words.resize(m_words.size() + m_words_per_row);
+      std::copy_n(m_words.begin() + row * m_words_per_row, m_words_per_row, m_words.end() - m_words_per_row);
+      ++m_rows;
+    }
+
+    /// \returns True iff row \a row of this matrix and row \a other_row of \a other have a common entry that is true.
+    /// \pre Both matrices have the same number of columns.
+    bool intersects(std::size_t row, const bit_matrix& other, std::size_t other_row) const
+    {
+      assert(m_columns == other.m_columns);
+      const word_type* first = &m_words[row * m_words_per_row];
+      const word_type* second = &other.m_words[other_row * m_words_per_row];
+      for (std::size_t i = 0; i < m_words_per_row; ++i)
+      {
+        if ((first[i] & second[i]) != 0)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// \returns The smallest column c >= \a column such that the entry (row, c) is true, or columns() if there is none.
+    std::size_t find_next(std::size_t row, std::size_t column) const
+    {
+      return find_next(row, column, m_columns);
+    }
+
+    /// \returns The smallest column c with \a column <= c < \a last such that the entry (row, c) is true,
+    ///          or \a last if there is none.
+    /// \details Only the words of the row that contain the columns in [column, last) are read.
+    std::size_t find_next(std::size_t row, std::size_t column, std::size_t last) const
+    {
+      assert(last <= m_columns);
+      if (column >= last)
+      {
+        return last;
+      }
+      const word_type* words = &m_words[row * m_words_per_row];
+      const std::size_t last_index = words_for(last);
+      std::size_t index = column / bits_per_word;
+      word_type word = words[index] & (~word_type(0) << (column % bits_per_word));
+      while (word == 0)
+      {
+        if (++index == last_index)
+        {
+          return last;
+        }
+        word = words[index];
+      }
+      return std::min(index * bits_per_word + count_trailing_zeros(word), last);
+    }
+
+    void swap(bit_matrix& other)
+    {
+      std::swap(m_rows, other.m_rows);
+      std::swap(m_columns, other.m_columns);
+      std::swap(m_words_per_row, other.m_words_per_row);
+      m_words.swap(other.m_words);
+    }
+
+    static std::size_t words_for(std::size_t columns)
+    {
+      return (columns + bits_per_word - 1) / bits_per_word;
+    }
+
+  private:
+    static std::size_t count_trailing_zeros(word_type word)
+    {
+      assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+      std::size_t result = 0;
+      while ((word & 1) == 0)
+      {
+        word >>= 1;
+        ++result;
+      }
+      return result;
+#endif
+    }
+
+    std::size_t m_rows = 0;
+    std::size_t m_columns = 0;
+    std::size_t m_words_per_row = 0;
+    std::vector<word_type> m_words;
+};
+
+} // namespace detail
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_DETAIL_SIM_BIT_MATRIX_H
@@ -21,6 +21,7 @@
 
 #include "mcrl2/lts/detail/liblts_bisim.h"
 #include "mcrl2/lts/detail/liblts_bisim_gjkw.h"
+#include "mcrl2/lts/detail/liblts_bisim_par.h"
 #include "mcrl2/lts/detail/liblts_weak_bisim.h"
 #include "mcrl2/lts/detail/liblts_add_an_action_loop.h"
 #include "mcrl2/lts/detail/liblts_ready_sim.h"
@@ -40,9 +41,12 @@ namespace lts
  * \param[in] l A labelled transition system that must be reduced.
  * \param[in] eq The equivalence with respect to which the LTS will be
  *            reduced.
+ * \param[in] number_of_threads The number of threads that may be used,
+ *            currently by the simulation equivalences and to remove
+ *            tau loops in the branching equivalences and tau-star reduction.
  **/
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l, lts_equivalence eq);
+void reduce(LTS_TYPE& l, lts_equivalence eq, std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is equivalent to another LTS.
  * \param[in] l1 The first LTS that will be compared.
@@ -51,6 +55,8 @@ void reduce(LTS_TYPE& l, lts_equivalence eq);
  *            compared.
  * \param[in] generate_counter_examples Whether to generate a counter example
  * \param[in] counter_example_file The file to store the counter example in
+ * \param[in] number_of_threads The number of threads used by the simulation equivalences
+ *            and to remove tau loops in the branching bisimulations.
  * \retval true if the LTSs are found to be equivalent.
  * \retval false otherwise.
  * \warning This function alters the internal data structure of
@@ -64,7 +70,8 @@ bool destructive_compare(LTS_TYPE& l1,
                          const lts_equivalence eq,
                          const bool generate_counter_examples = false,
                          const std::string& counter_example_file = std::string(),
-                         const bool structured_output = false)
+                         const bool structured_output = false,
+                         const std::size_t number_of_threads = 1)
 {
   // Merge this LTS and l and store the result in this LTS.
   // In the resulting LTS, the initial state i of l will have the
@@ -99,7 +106,7 @@ bool destructive_compare(LTS_TYPE& l1,
         mCRL2log(mcrl2::log::warning) << "The default branching bisimulation comparison algorithm cannot generate counter examples. Therefore the slower gv algorithm is used instead.\n";
         return detail::destructive_bisimulation_compare(l1,l2, true,false,generate_counter_examples,counter_example_file,structured_output);
       }
-      return detail::destructive_bisimulation_compare_dnj(l1,l2, true,false,generate_counter_examples,counter_example_file,structured_output);
+      return detail::destructive_bisimulation_compare_dnj(l1,l2, true,false,generate_counter_examples,counter_example_file,structured_output,number_of_threads);
     }
     case lts_eq_branching_bisim_gv:
     {
@@ -107,7 +114,15 @@ bool destructive_compare(LTS_TYPE& l1,
     }
     case lts_eq_branching_bisim_gjkw:
     {
-      return detail::destructive_bisimulation_compare_gjkw(l1,l2, true,false,generate_counter_examples,counter_example_file,structured_output);
+      return detail::destructive_bisimulation_compare_gjkw(l1,l2, true,false,generate_counter_examples,counter_example_file,structured_output,number_of_threads);
+    }
+    case lts_eq_branching_bisim_par:
+    {
+      if (generate_counter_examples)
+      {
+        mCRL2log(mcrl2::log::warning) << "The multi-threaded branching bisimulation algorithm does not generate counterexamples.\n";
+      }
+      return detail::destructive_bisimulation_compare_par(l1,l2, true,false,number_of_threads);
     }
     case lts_eq_divergence_preserving_branching_bisim:
     {
@@ -116,7 +131,7 @@ bool destructive_compare(LTS_TYPE& l1,
         mCRL2log(mcrl2::log::warning) << "The default divergence-preserving branching bisimulation comparison algorithm cannot generate counter examples. Therefore the slower gv algorithm is used instead.\n";
         return detail::destructive_bisimulation_compare(l1,l2, true,true,generate_counter_examples,counter_example_file,structured_output);
       }
-      return detail::destructive_bisimulation_compare_dnj(l1,l2, true,true,generate_counter_examples,counter_example_file,structured_output);
+      return detail::destructive_bisimulation_compare_dnj(l1,l2, true,true,generate_counter_examples,counter_example_file,structured_output,number_of_threads);
     }
     case lts_eq_divergence_preserving_branching_bisim_gv:
     {
@@ -124,7 +139,15 @@ bool destructive_compare(LTS_TYPE& l1,
     }
     case lts_eq_divergence_preserving_branching_bisim_gjkw:
     {
-      return detail::destructive_bisimulation_compare_gjkw(l1,l2, true,true,generate_counter_examples,counter_example_file,structured_output);
+      return detail::destructive_bisimulation_compare_gjkw(l1,l2, true,true,generate_counter_examples,counter_example_file,structured_output,number_of_threads);
+    }
+    case lts_eq_divergence_preserving_branching_bisim_par:
+    {
+      if (generate_counter_examples)
+      {
+        mCRL2log(mcrl2::log::warning) << "The multi-threaded divergence-preserving branching bisimulation algorithm does not generate counterexamples.\n";
+      }
+      return detail::destructive_bisimulation_compare_par(l1,l2, true,true,number_of_threads);
     }
     case lts_eq_weak_bisim:
     {
@@ -152,7 +175,7 @@ bool destructive_compare(LTS_TYPE& l1,
       std::size_t init_l2 = l2.initial_state() + l1.num_states();
       detail::merge(l1,l2);
       l2.clear(); // l2 is not needed anymore.
-      detail::sim_partitioner<LTS_TYPE> sp(l1);
+      detail::sim_partitioner<LTS_TYPE> sp(l1, number_of_threads);
       sp.partitioning_algorithm();
 
       return sp.in_same_class(l1.initial_state(),init_l2);
@@ -167,7 +190,7 @@ bool destructive_compare(LTS_TYPE& l1,
       std::size_t init_l2 = l2.initial_state() + l1.num_states();
       detail::merge(l1,l2);
       l2.clear(); // l2 is not needed anymore.
-      detail::ready_sim_partitioner<LTS_TYPE> rsp(l1);
+      detail::ready_sim_partitioner<LTS_TYPE> rsp(l1, number_of_threads);
       rsp.partitioning_algorithm();
 
       return rsp.in_same_class(l1.initial_state(),init_l2);
@@ -230,6 +253,8 @@ bool destructive_compare(LTS_TYPE& l1,
  *            compared.
  * \param[in] generate_counter_examples Whether to generate a counter example
  * \param[in] counter_example_file The file to store the counter example in
+ * \param[in] number_of_threads The number of threads used by the simulation equivalences
+ *            and to remove tau loops in the branching bisimulations.
  * \retval true if the LTSs are found to be equivalent.
  * \retval false otherwise.
  */
@@ -239,7 +264,8 @@ bool compare(const LTS_TYPE& l1,
              const lts_equivalence eq,
              const bool generate_counter_examples = false,
              const std::string& counter_example_file = "",
-             const bool structured_output = false);
+             const bool structured_output = false,
+             const std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is smaller than another LTS according
  * to a preorder.
@@ -252,6 +278,7 @@ bool compare(const LTS_TYPE& l1,
  * \param[in] strategy Choose breadth-first or depth-first for exploration strategy
  *            of the antichain algorithms.
  * \param[in] preprocess Whether to allow preprocessing of the given LTSs.
+ * \param[in] number_of_threads The number of threads used by the simulation preorders.
  * \retval true if LTS \a l1 is smaller than LTS \a l2 according to
  * preorder \a pre.
  * \retval false otherwise.
@@ -270,7 +297,8 @@ bool destructive_compare(LTS_TYPE& l1,
                          const std::string& counter_example_file = "",
                          const bool structured_output = false,
                          const lps::exploration_strategy strategy = lps::es_breadth,
-                         const bool preprocess = true);
+                         const bool preprocess = true,
+                         const std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is smaller than another LTS according
  * to a preorder.
@@ -282,6 +310,7 @@ bool destructive_compare(LTS_TYPE& l1,
  * \param[in] strategy Choose breadth-first or depth-first for exploration strategy
  *            of the antichain algorithms.
  * \param[in] preprocess Whether to allow preprocessing of the given LTSs.
+ * \param[in] number_of_threads The number of threads used by the simulation preorders.
  * \retval true if this LTS is smaller than LTS \a l according to
  * preorder \a pre.
  * \retval false otherwise.
@@ -294,7 +323,8 @@ bool compare(const LTS_TYPE&  l1,
              const std::string& counter_example_file = "",
              const bool structured_output = false,
              const lps::exploration_strategy strategy = lps::es_breadth,
-             const bool preprocess = true);
+             const bool preprocess = true,
+             const std::size_t number_of_threads = 1);
 
 /** \brief Determinises this LTS. */
 template <class LTS_TYPE>
@@ -577,6 +607,77 @@ bool reachability_check(probabilistic_lts < SL, AL, PROBABILISTIC_STATE, BASE>&
   return all_reachable;
 }
 
+/** \brief Renumbers the states of an lts in breadth-first order and sorts its transitions.
+ * \details The states are numbered in the order in which a breadth-first search
+ * starting in the initial state visits them. Unreachable states are numbered
+ * afterwards, by breadth-first searches from the first state that has not been
+ * numbered yet. Afterwards the transitions are sorted on source, label and target.
+ * States that are close in the transition graph thus obtain nearby numbers,
+ * and the transitions of each state are stored consecutively, which improves the
+ * locality of memory accesses of the algorithms that operate on the lts.
+ * \param[in,out] l The lts that is renumbered.
+ * \return A vector that maps each original state number to its new number. */
+template <class SL, class AL, class BASE>
+std::vector<std::size_t> relayout(lts<SL, AL, BASE>& l)
+{
+  const std::size_t n = l.num_states();
+  std::vector<std::size_t> new_number(n, n);
+  if (n == 0)
+  {
+    return new_number;
+  }
+
+  const outgoing_transitions_per_state_t out_trans(l.get_transitions(), n, true);
+  std::vector<std::size_t> order;
+  order.reserve(n);
+  std::size_t root = l.initial_state();
+  std::size_t next_root = 0;
+  while (true)
+  {
+    new_number[root] = order.size();
+    order.push_back(root);
+    for (std::size_t head = order.size() - 1; head < order.size(); ++head)
+    {
+      const std::size_t s = order[head];
+      for (detail::state_type i = out_trans.lowerbound(s); i < out_trans.upperbound(s); ++i)
+      {
+        const std::size_t t = to(out_trans.get_transitions()[i]);
+        if (new_number[t] == n)
+        {
+          new_number[t] = order.size();
+          order.push_back(t);
+        }
+      }
+    }
+    while (next_root < n && new_number[next_root] != n)
+    {
+      ++next_root;
+    }
+    if (next_root == n)
+    {
+      break;
+    }
+    root = next_root;
+  }
+
+  for (transition& t: l.get_transitions())
+  {
+    t = transition(new_number[t.from()], t.label(), new_number[t.to()]);
+  }
+  sort_transitions(l.get_transitions(), src_lbl_tgt);
+  if (l.has_state_info())
+  {
+    std::vector<SL> new_labels(n);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      new_labels[new_number[s]] = l.state_label(s);
+    }
+    l.state_labels().swap(new_labels);
+  }
+  l.set_initial_state(new_number[l.initial_state()]);
+  return new_number;
+}
+
 /** \brief Checks whether this LTS is deterministic.
  * \retval true if this LTS is deterministic;
  * \retval false otherwise. */
@@ -600,8 +701,25 @@ void merge(LTS_TYPE& l1, const LTS_TYPE& l2)
 
 
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l,lts_equivalence eq)
+void reduce(LTS_TYPE& l,lts_equivalence eq,std::size_t number_of_threads)
 {
+  // The O(m log n) partitioners access the transitions of a state and of its successors
+  // together. Renumbering the states first avoids a cache miss on nearly every access when
+  // the states are numbered in an arbitrary order, e.g., after multi-threaded generation.
+  // The quotient does not depend on the numbering, so the permutation needs not be undone.
+  switch (eq)
+  {
+    case lts_eq_bisim:
+    case lts_eq_bisim_gjkw:
+    case lts_eq_branching_bisim:
+    case lts_eq_branching_bisim_gjkw:
+    case lts_eq_divergence_preserving_branching_bisim:
+    case lts_eq_divergence_preserving_branching_bisim_gjkw:
+      relayout(l);
+      break;
+    default:
+      break;
+  }
 
   switch (eq)
   {
@@ -630,7 +748,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_branching_bisim:
     {
-      detail::bisimulation_reduce_dnj(l,true,false);
+      detail::bisimulation_reduce_dnj(l,true,false,number_of_threads);
       return;
     }
     case lts_eq_branching_bisim_gv:
@@ -640,7 +758,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_branching_bisim_gjkw:
     {
-      detail::bisimulation_reduce_gjkw(l,true,false);
+      detail::bisimulation_reduce_gjkw(l,true,false,number_of_threads);
       return;
     }
     case lts_eq_branching_bisim_sigref:
@@ -649,9 +767,14 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       s.run();
       return;
     }
+    case lts_eq_branching_bisim_par:
+    {
+      detail::bisimulation_reduce_par(l,true,false,number_of_threads);
+      return;
+    }
     case lts_eq_divergence_preserving_branching_bisim:
     {
-      detail::bisimulation_reduce_dnj(l,true,true);
+      detail::bisimulation_reduce_dnj(l,true,true,number_of_threads);
       return;
     }
     case lts_eq_divergence_preserving_branching_bisim_gv:
@@ -661,7 +784,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_divergence_preserving_branching_bisim_gjkw:
     {
-      detail::bisimulation_reduce_gjkw(l,true,true);
+      detail::bisimulation_reduce_gjkw(l,true,true,number_of_threads);
       return;
     }
     case lts_eq_divergence_preserving_branching_bisim_sigref:
@@ -670,6 +793,11 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       s.run();
       return;
     }
+    case lts_eq_divergence_preserving_branching_bisim_par:
+    {
+      detail::bisimulation_reduce_par(l,true,true,number_of_threads);
+      return;
+    }
     case lts_eq_weak_bisim:
     {
       detail::weak_bisimulation_reduce(l,false);
@@ -717,7 +845,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     case lts_eq_sim:
     {
       // Run the partitioning algorithm on this LTS
-      detail::sim_partitioner<LTS_TYPE> sp(l);
+      detail::sim_partitioner<LTS_TYPE> sp(l, number_of_threads);
       sp.partitioning_algorithm();
 
       // Clear this LTS, but keep the labels
@@ -744,7 +872,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     case lts_eq_ready_sim:
     {
       // Run the partitioning algorithm on this LTS
-      detail::ready_sim_partitioner<LTS_TYPE> rsp(l);
+      detail::ready_sim_partitioner<LTS_TYPE> rsp(l, number_of_threads);
       rsp.partitioning_algorithm();
 
       // Clear this LTS, but keep the labels
@@ -775,7 +903,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       return;
     case lts_eq_weak_trace:
     {
-      detail::bisimulation_reduce(l,true,false);
+      detail::bisimulation_reduce(l,true,false,number_of_threads);
       detail::tau_star_reduce(l);
       detail::bisimulation_reduce(l,false);
       determinise(l);
@@ -784,7 +912,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_red_tau_star:
     {
-      detail::bisimulation_reduce(l,true,false);
+      detail::bisimulation_reduce(l,true,false,number_of_threads);
       detail::tau_star_reduce(l);
       detail::bisimulation_reduce(l,false);
       return;
@@ -800,7 +928,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
 }
 
 template <class LTS_TYPE>
-bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, const bool generate_counter_examples, const std::string& counter_example_file, const bool structured_output)
+bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, const bool generate_counter_examples, const std::string& counter_example_file, const bool structured_output, const std::size_t number_of_threads)
 {
   switch (eq)
   {
@@ -809,21 +937,21 @@ bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, c
     default:
       LTS_TYPE l1_copy(l1);
       LTS_TYPE l2_copy(l2);
-      return destructive_compare(l1_copy, l2_copy, eq ,generate_counter_examples, counter_example_file, structured_output);
+      return destructive_compare(l1_copy, l2_copy, eq ,generate_counter_examples, counter_example_file, structured_output, number_of_threads);
   }
   return false;
 }
 
 template <class LTS_TYPE>
-bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess)
+bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess, const std::size_t number_of_threads)
 {
   LTS_TYPE l1_copy(l1);
   LTS_TYPE l2_copy(l2);
-  return destructive_compare(l1_copy, l2_copy, pre, generate_counter_example, counter_example_file, structured_output, strategy, preprocess);
+  return destructive_compare(l1_copy, l2_copy, pre, generate_counter_example, counter_example_file, structured_output, strategy, preprocess, number_of_threads);
 }
 
 template <class LTS_TYPE>
-bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess)
+bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess, const std::size_t number_of_threads)
 {
   switch (pre)
   {
@@ -840,7 +968,7 @@ bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, con
       l2.clear();
 
       // Run the partitioning algorithm on this merged LTS
-      detail::sim_partitioner<LTS_TYPE> sp(l1);
+      detail::sim_partitioner<LTS_TYPE> sp(l1, number_of_threads);
       sp.partitioning_algorithm();
 
       return sp.in_preorder(l1.initial_state(),init_l2);
@@ -858,7 +986,7 @@ bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, con
       l2.clear();
 
       // Run the partitioning algorithm on this prepropcessed LTS
-      detail::ready_sim_partitioner<LTS_TYPE> rsp(l1);
+      detail::ready_sim_partitioner<LTS_TYPE> rsp(l1, number_of_threads);
       rsp.partitioning_algorithm();
 
       return rsp.in_preorder(l1.initial_state(),init_l2);
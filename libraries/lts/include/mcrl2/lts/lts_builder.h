@@ -14,6 +14,7 @@
 
 #include "mcrl2/lps/explorer.h"
 #include "mcrl2/lts/detail/lts_convert.h"
+#include "mcrl2/lts/lts_clts.h"
 #include "mcrl2/lts/lts_io.h"
 
 namespace mcrl2 {
@@ -320,6 +321,20 @@ class lts_fsm_builder: public lts_lts_builder
     }
 };
 
+class lts_clts_builder: public lts_lts_builder
+{
+  public:
+    typedef lts_lts_builder super;
+    lts_clts_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters, bool discard_state_labels = false)
+      : super(dataspec, action_labels, process_parameters, discard_state_labels)
+    { }
+
+    void save(const std::string& filename) override
+    {
+      save_clts(m_lts, filename);
+    }
+};
+
 inline
 std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspec, const lps::explorer_options& options, lts_type output_format, const std::string& output_filename = "")
 {
@@ -338,6 +353,7 @@ std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspe
     }
     case lts_dot: return std::make_unique<lts_dot_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
     case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
+    case lts_clts: return std::make_unique<lts_clts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
     case lts_lts:
     {
       if (options.save_at_end)
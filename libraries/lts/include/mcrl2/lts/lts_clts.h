@@ -0,0 +1,137 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/** \file lts_clts.h
+ *
+ * \brief Reading and writing labelled transition systems in the columnar .clts format.
+ * \details A .clts file stores the transitions of an lts sorted on their source state in
+ *          blocks of a fixed number of transitions. Within a block the source states, labels
+ *          and target states are stored as separate columns of delta encoded variable length
+ *          integers, and every block can be compressed individually. A block index, which is
+ *          stored uncompressed, makes it possible to find the outgoing transitions of a state
+ *          without decoding the whole file. The data specification, process parameters, action
+ *          labels and state labels are stored as separate binary aterm streams, such that the
+ *          state labels can be skipped when they are not needed.
+ *
+ *          The layout of a file is as follows, where all fixed size integers are little endian.
+ *          \li A header of clts_header_size bytes, see detail::clts_header.
+ *          \li A binary aterm stream with the data specification, process parameters,
+ *              action label declarations and the action labels.
+ *          \li A binary aterm stream containing the state labels, if present.
+ *          \li The transition blocks.
+ *          \li The block index containing one detail::clts_block_info per block. It is stored
+ *              after the blocks, such that the blocks can be written while they are produced.
+ */
+
+#ifndef MCRL2_LTS_LTS_CLTS_H
+#define MCRL2_LTS_LTS_CLTS_H
+
+#include "mcrl2/lts/lts_lts.h"
+#include "mcrl2/utilities/memory_mapped_file.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+
+/// \brief The default number of transitions that is stored in a single block of a .clts file.
+constexpr std::size_t clts_default_block_size = 4096;
+
+namespace detail
+{
+
+/// \brief The fixed size header at the start of every .clts file.
+struct clts_header
+{
+  std::uint32_t version = 0;
+  std::uint32_t flags = 0;
+  std::uint64_t num_states = 0;
+  std::uint64_t num_transitions = 0;
+  std::uint64_t num_action_labels = 0;
+  std::uint64_t initial_state = 0;
+  std::uint64_t num_blocks = 0;
+  std::uint64_t metadata_offset = 0;
+  std::uint64_t metadata_size = 0;
+  std::uint64_t state_labels_offset = 0;
+  std::uint64_t state_labels_size = 0;
+  std::uint64_t index_offset = 0;
+};
+
+/// \brief The information on a single transition block, which is stored in the block index.
+struct clts_block_info
+{
+  std::uint64_t first_state = 0;     ///< The source state of the first transition in this block.
+  std::uint64_t offset = 0;          ///< The position of this block in the file.
+  std::uint32_t stored_size = 0;     ///< The number of bytes of this block in the file.
+  std::uint32_t raw_size = 0;        ///< The number of bytes of this block after decompression.
+  std::uint32_t num_transitions = 0; ///< The number of transitions in this block.
+  std::uint32_t compressed = 0;      ///< Non zero iff this block is compressed.
+};
+
+} // namespace detail
+
+/// \brief Provides random access to the transitions in a .clts file without reading the whole file.
+/// \details The file is memory mapped, and only the blocks that are accessed are decoded.
+class clts_reader : private utilities::noncopyable
+{
+  public:
+    /// \brief Opens the .clts file with the given name, throws a runtime_error if it is not a valid .clts file.
+    explicit clts_reader(const std::string& filename);
+
+    std::size_t num_states() const { return m_header.num_states; }
+    std::size_t num_transitions() const { return m_header.num_transitions; }
+    std::size_t num_action_labels() const { return m_header.num_action_labels; }
+    std::size_t initial_state() const { return m_header.initial_state; }
+    std::size_t num_blocks() const { return m_header.num_blocks; }
+
+    /// \returns True iff the file contains state labels.
+    bool has_state_labels() const;
+
+    /// \brief Sets the data specification, process parameters, action label declarations,
+    ///        action labels, number of states and the initial state of the given lts.
+    void read_header(lts_lts_t& lts) const;
+
+    /// \brief Appends the state labels stored in the file to the given vector.
+    void read_state_labels(std::vector<state_label_lts>& labels) const;
+
+    /// \brief Appends the transitions of the given block to the result.
+    void read_block(std::size_t block, std::vector<transition>& result) const;
+
+    /// \brief Appends the outgoing transitions of the given state to the result.
+    /// \details Only the blocks that contain transitions of the state are decoded.
+    void outgoing_transitions(std::size_t state, std::vector<transition>& result) const;
+
+  private:
+    detail::clts_block_info block_info(std::size_t block) const;
+
+    utilities::memory_mapped_file m_file;
+    detail::clts_header m_header;
+};
+
+/// \returns True iff the file with the given name starts with the signature of a .clts file.
+bool is_clts_file(const std::string& filename);
+
+/// \brief Saves the lts to a file in the .clts format.
+/// \param[in] lts The lts to be saved. The hidden label map is applied to the labels of its transitions.
+/// \param[in] filename The name of the file, which cannot be empty as the format requires random access.
+/// \param[in] compress If true the transition blocks are compressed whenever that reduces their size.
+/// \param[in] block_size The number of transitions per block.
+void save_clts(const lts_lts_t& lts,
+               const std::string& filename,
+               bool compress = true,
+               std::size_t block_size = clts_default_block_size);
+
+/// \brief Loads an lts from a file in the .clts format.
+/// \details The transitions are decoded directly from the memory mapped file.
+void load_clts(lts_lts_t& lts, const std::string& filename);
+
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_LTS_CLTS_H
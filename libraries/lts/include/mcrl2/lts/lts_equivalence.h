@@ -39,10 +39,12 @@ enum lts_equivalence
   lts_eq_branching_bisim_gv,     /**< Branching bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
   lts_eq_branching_bisim_gjkw,   /**< Branching bisimulation equivalence using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017 */
   lts_eq_branching_bisim_sigref, /**< Branching bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_branching_bisim_par, /**< Branching bisimulation equivalence using the multi-threaded signature refinement algorithm */
   lts_eq_divergence_preserving_branching_bisim, /**< Divergence-preserving branching bisimulation equivalence using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019] */
   lts_eq_divergence_preserving_branching_bisim_gv,    /**< Divergence-preserving branching bisimulation equivalence using the O(mn) algorithm [Groote/Vaandrager 1990] */
   lts_eq_divergence_preserving_branching_bisim_gjkw,   /**< Divergence-preserving branching bisimulation equivalence using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017] */
   lts_eq_divergence_preserving_branching_bisim_sigref, /** Divergence-preserving branching bisimulation equivalence using the signature refinement algorithm [Blom/Orzan 2003] */
+  lts_eq_divergence_preserving_branching_bisim_par, /**< Divergence-preserving branching bisimulation equivalence using the multi-threaded signature refinement algorithm */
   lts_eq_weak_bisim,  /**< Weak bisimulation equivalence */
   lts_eq_divergence_preserving_weak_bisim, /**< Divergence-preserving weak bisimulation equivalence */
   lts_eq_sim,              /**< Strong simulation equivalence */
@@ -69,12 +71,16 @@ enum lts_equivalence
  *          algorithm [Groote/Vaandrager 1990];
  * \li "branching-bisim-sig" for branching bisimilarity using the signature
  *          refinement algorithm [Blom/Orzan 2003];
+ * \li "branching-bisim-par" for branching bisimilarity using the
+ *          multi-threaded signature refinement algorithm;
  * \li "dpbranching-bisim" for divergence-preserving branching bisimilarity
  *          using the O(m log n) algorithm [Groote/Jansen/Keiren/Wijs 2017];
  * \li "dpbranching-bisim-gv" for divergence-preserving branching bisimilarity
  *          using the O(mn) algorithm [Groote/Vaandrager 1990];
  * \li "dpbranching-bisim-sig" for divergence-preserving branching bisimilarity
  *          using the signature refinement algorithm [Blom/Orzan 2003];
+ * \li "dpbranching-bisim-par" for divergence-preserving branching bisimilarity
+ *          using the multi-threaded signature refinement algorithm;
  * \li "weak-bisim" for weak bisimilarity;
  * \li "dpweak-bisim" for divergence-preserving weak bisimilarity;
  * \li "sim" for strong simulation equivalence;
@@ -124,6 +130,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_branching_bisim_sigref;
   }
+  else if (s == "branching-bisim-par")
+  {
+    return lts_eq_branching_bisim_par;
+  }
   else if (s == "dpbranching-bisim")
   {
     return lts_eq_divergence_preserving_branching_bisim;
@@ -140,6 +150,10 @@ lts_equivalence parse_equivalence(std::string const& s)
   {
     return lts_eq_divergence_preserving_branching_bisim_sigref;
   }
+  else if (s == "dpbranching-bisim-par")
+  {
+    return lts_eq_divergence_preserving_branching_bisim_par;
+  }
   else if (s == "weak-bisim")
   {
     return lts_eq_weak_bisim;
@@ -226,6 +240,8 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "branching-bisim-gjkw";
     case lts_eq_branching_bisim_sigref:
       return "branching-bisim-sig";
+    case lts_eq_branching_bisim_par:
+      return "branching-bisim-par";
     case lts_eq_divergence_preserving_branching_bisim:
       return "dpbranching-bisim";
     case lts_eq_divergence_preserving_branching_bisim_gv:
@@ -234,6 +250,8 @@ inline std::string print_equivalence(const lts_equivalence eq)
       return "dpbranching-bisim-gjkw";
     case lts_eq_divergence_preserving_branching_bisim_sigref:
       return "dpbranching-bisim-sig";
+    case lts_eq_divergence_preserving_branching_bisim_par:
+      return "dpbranching-bisim-par";
     case lts_eq_weak_bisim:
       return "weak-bisim";
     case lts_eq_divergence_preserving_weak_bisim:
@@ -291,6 +309,8 @@ inline std::string description(const lts_equivalence eq)
       return "branching bisimilarity using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017]";
     case lts_eq_branching_bisim_sigref:
       return "branching bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_branching_bisim_par:
+      return "branching bisimilarity using the multi-threaded signature refinement algorithm (see --threads)";
     case lts_eq_divergence_preserving_branching_bisim:
       return "divergence-preserving branching bisimilarity using the O(m log n) algorithm [Jansen/Groote/Keiren/Wijs 2019]";
     case lts_eq_divergence_preserving_branching_bisim_gv:
@@ -299,6 +319,8 @@ inline std::string description(const lts_equivalence eq)
       return "divergence-preserving branching bisimilarity using the O(m log m) algorithm [Groote/Jansen/Keiren/Wijs 2017]";
     case lts_eq_divergence_preserving_branching_bisim_sigref:
       return "divergence-preserving branching bisimilarity using the signature refinement algorithm [Blom/Orzan 2003]";
+    case lts_eq_divergence_preserving_branching_bisim_par:
+      return "divergence-preserving branching bisimilarity using the multi-threaded signature refinement algorithm (see --threads)";
     case lts_eq_weak_bisim:
       return "weak bisimilarity";
     case lts_eq_divergence_preserving_weak_bisim:
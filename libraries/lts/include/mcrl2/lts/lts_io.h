@@ -208,6 +208,7 @@ inline void load_lts(lts_lts_t& result,
   {
     case lts_lts:
     case lts_lts_probabilistic:
+    case lts_clts:
     {
       if (extra_data_file_type != none_e)
       {
@@ -256,6 +257,7 @@ inline void load_lts_as_fsm_file(const std::string& path, lts_fsm_t& l)
   {
     case lts_lts:
     case lts_lts_probabilistic:
+    case lts_clts:
     {
       lts_lts_t l1;
       l1.load(path);
@@ -40,11 +40,12 @@ enum lts_type
   lts_aut,                   /**< Ald&eacute;baran format (CADP) */
   lts_fsm,                   /**< FSM format */
   lts_dot,                   /**< GraphViz format */
+  lts_clts,                  /**< mCRL2 columnar LTS format */
   lts_lts_probabilistic,     
   lts_aut_probabilistic,
   lts_fsm_probabilistic,
   lts_type_min=lts_none,
-  lts_type_max=lts_dot
+  lts_type_max=lts_clts
 };
 
 }
@@ -63,14 +63,22 @@ lts_type guess_format(std::string const& s, const bool be_verbose/*=true*/)
       }
       return lts_dot;
     }
+    else if (ext == "clts")
+    {
+      if (be_verbose)
+      {
+        mCRL2log(verbose) << "Detected .clts extension.\n";
+      }
+      return lts_clts;
+    }
   }
 
   return lts_none;
 }
 
-static const std::string type_strings[] = { "unknown", "lts", "aut", "fsm", "dot" };
+static const std::string type_strings[] = { "unknown", "lts", "aut", "fsm", "dot", "clts" };
 
-static const std::string extension_strings[] = { "", "lts", "aut", "fsm", "dot" };
+static const std::string extension_strings[] = { "", "lts", "aut", "fsm", "dot", "clts" };
 
 static std::string type_desc_strings[] = {
     "unknown LTS format",
@@ -78,7 +86,7 @@ static std::string type_desc_strings[] = {
     "Aldebaran format (CADP)",
     "Finite State Machine format",
     "GraphViz format (no longer supported as input format)",
-    "SVC format"
+    "compressed columnar mCRL2 LTS format"
                                          };
 
 
@@ -86,7 +94,8 @@ static std::string mime_type_strings[] = { "",
     "application/lts",
     "text/aut",
     "text/fsm",
-    "text/dot"
+    "text/dot",
+    "application/clts"
                                          };
 
 lts_type parse_format(std::string const& s)
@@ -107,6 +116,10 @@ lts_type parse_format(std::string const& s)
   {
     return lts_dot;
   }
+  else if (s == "clts")
+  {
+    return lts_clts;
+  }
   return lts_none;
 }
 
@@ -0,0 +1,575 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file liblts_clts.cpp
+
+#include "mcrl2/lts/lts_clts.h"
+#include "mcrl2/lts/lts_io.h"
+
+#include "mcrl2/utilities/block_compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <tuple>
+
+namespace mcrl2::lts
+{
+
+namespace detail
+{
+
+// The first bytes of every .clts file.
+static const char clts_magic[8] = { 'm', 'C', 'R', 'L', '2', 'L', 'T', 'C' };
+
+static const std::uint32_t clts_version = 1;
+
+// Flags stored in the header.
+static const std::uint32_t clts_has_state_labels = 1;
+
+static const std::size_t clts_header_size = sizeof(clts_magic) + 2 * 4 + 10 * 8;
+static const std::size_t clts_block_info_size = 2 * 8 + 4 * 4;
+
+// Encoding and decoding of little endian integers.
+
+static void put_uint32(std::vector<std::uint8_t>& output, std::uint32_t value)
+{
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    output.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+static void put_uint64(std::vector<std::uint8_t>& output, std::uint64_t value)
+{
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    output.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+static std::uint32_t get_uint32(const std::uint8_t*& input)
+{
+  std::uint32_t value = 0;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    value |= static_cast<std::uint32_t>(input[i]) << (8 * i);
+  }
+  input += 4;
+  return value;
+}
+
+static std::uint64_t get_uint64(const std::uint8_t*& input)
+{
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    value |= static_cast<std::uint64_t>(input[i]) << (8 * i);
+  }
+  input += 8;
+  return value;
+}
+
+// Variable length encoding of integers, using seven bits per byte where the most significant bit indicates that more bytes follow.
+
+static void put_varint(std::vector<std::uint8_t>& output, std::uint64_t value)
+{
+  while (value > 127)
+  {
+    output.push_back(static_cast<std::uint8_t>(value & 127) | 128);
+    value >>= 7;
+  }
+  output.push_back(static_cast<std::uint8_t>(value));
+}
+
+static std::uint64_t get_varint(const std::uint8_t*& input, const std::uint8_t* end)
+{
+  std::uint64_t value = 0;
+  for (std::size_t shift = 0; shift < 64; shift += 7)
+  {
+    if (input == end)
+    {
+      throw mcrl2::runtime_error("Transition block of .clts file ends unexpectedly.");
+    }
+
+    const std::uint8_t byte = *input++;
+    value |= static_cast<std::uint64_t>(byte & 127) << shift;
+    if ((byte & 128) == 0)
+    {
+      return value;
+    }
+  }
+  throw mcrl2::runtime_error("Transition block of .clts file contains an invalid number.");
+}
+
+// Target states are stored relative to the source state, which can be negative.
+
+static std::uint64_t zigzag_encode(std::int64_t value)
+{
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+static std::int64_t zigzag_decode(std::uint64_t value)
+{
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+static void write_header(std::vector<std::uint8_t>& output, const clts_header& header)
+{
+  output.insert(output.end(), clts_magic, clts_magic + sizeof(clts_magic));
+  put_uint32(output, header.version);
+  put_uint32(output, header.flags);
+  put_uint64(output, header.num_states);
+  put_uint64(output, header.num_transitions);
+  put_uint64(output, header.num_action_labels);
+  put_uint64(output, header.initial_state);
+  put_uint64(output, header.num_blocks);
+  put_uint64(output, header.metadata_offset);
+  put_uint64(output, header.metadata_size);
+  put_uint64(output, header.state_labels_offset);
+  put_uint64(output, header.state_labels_size);
+  put_uint64(output, header.index_offset);
+  assert(output.size() == clts_header_size);
+}
+
+static clts_header read_header(const std::uint8_t* input, std::size_t size)
+{
+  if (size < clts_header_size || std::memcmp(input, clts_magic, sizeof(clts_magic)) != 0)
+  {
+    throw mcrl2::runtime_error("The file does not contain an lts in .clts format.");
+  }
+  input += sizeof(clts_magic);
+
+  clts_header header;
+  header.version = get_uint32(input);
+  if (header.version != clts_version)
+  {
+    throw mcrl2::runtime_error("The .clts file has version " + std::to_string(header.version) +
+                               ", but only version " + std::to_string(clts_version) + " is supported.");
+  }
+
+  header.flags = get_uint32(input);
+  header.num_states = get_uint64(input);
+  header.num_transitions = get_uint64(input);
+  header.num_action_labels = get_uint64(input);
+  header.initial_state = get_uint64(input);
+  header.num_blocks = get_uint64(input);
+  header.metadata_offset = get_uint64(input);
+  header.metadata_size = get_uint64(input);
+  header.state_labels_offset = get_uint64(input);
+  header.state_labels_size = get_uint64(input);
+  header.index_offset = get_uint64(input);
+
+  // Every term is compared separately with the size, such that a corrupt header cannot cause an overflow.
+  if (header.metadata_offset > size || header.metadata_size > size - header.metadata_offset ||
+      header.state_labels_offset > size || header.state_labels_size > size - header.state_labels_offset ||
+      header.index_offset > size || header.num_blocks > (size - header.index_offset) / clts_block_info_size ||
+      header.num_action_labels == 0 ||
+      (header.num_states > 0 && header.initial_state >= header.num_states))
+  {
+    throw mcrl2::runtime_error("The .clts file is truncated or corrupt.");
+  }
+  return header;
+}
+
+/// \brief Encodes the transitions of the lts with the indices in [begin, end), which are sorted on
+///        their source state, as columns. The hidden label map is applied to their labels.
+static void encode_block(const lts_lts_t& lts,
+                         std::vector<std::size_t>::const_iterator begin,
+                         std::vector<std::size_t>::const_iterator end,
+                         std::vector<std::uint8_t>& output)
+{
+  const std::vector<transition>& transitions = lts.get_transitions();
+  std::size_t previous = transitions[*begin].from();
+  for (auto i = begin; i != end; ++i)
+  {
+    put_varint(output, transitions[*i].from() - previous);
+    previous = transitions[*i].from();
+  }
+
+  for (auto i = begin; i != end; ++i)
+  {
+    put_varint(output, lts.apply_hidden_label_map(transitions[*i].label()));
+  }
+
+  for (auto i = begin; i != end; ++i)
+  {
+    put_varint(output, zigzag_encode(static_cast<std::int64_t>(transitions[*i].to()) - static_cast<std::int64_t>(transitions[*i].from())));
+  }
+}
+
+static void write_bytes(std::ofstream& stream, const void* data, std::size_t size)
+{
+  stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+/// \brief Decodes a block produced by encode_block and appends its transitions to the result.
+static void decode_block(const std::uint8_t* input,
+                         std::size_t size,
+                         const clts_block_info& info,
+                         std::size_t num_states,
+                         std::size_t num_action_labels,
+                         std::vector<transition>& result)
+{
+  const std::uint8_t* const end = input + size;
+  const std::size_t first = result.size();
+
+  std::size_t from = info.first_state;
+  for (std::size_t i = 0; i < info.num_transitions; ++i)
+  {
+    from += get_varint(input, end);
+    result.emplace_back(from, 0, 0);
+  }
+
+  for (std::size_t i = first; i < result.size(); ++i)
+  {
+    result[i].set_label(get_varint(input, end));
+  }
+
+  for (std::size_t i = first; i < result.size(); ++i)
+  {
+    result[i].set_to(static_cast<std::size_t>(static_cast<std::int64_t>(result[i].from()) + zigzag_decode(get_varint(input, end))));
+  }
+
+  if (input != end ||
+      std::any_of(result.begin() + first, result.end(),
+                  [&](const transition& t)
+                  {
+                    return t.from() >= num_states || t.to() >= num_states || t.label() >= num_action_labels;
+                  }))
+  {
+    throw mcrl2::runtime_error("Transition block of .clts file is corrupt.");
+  }
+}
+
+/// \brief Writes the contents of a binary aterm stream filled by the given function to a buffer.
+template <typename WRITE_FUNCTION>
+static std::string write_aterm_section(WRITE_FUNCTION write)
+{
+  std::stringstream buffer;
+  {
+    atermpp::binary_aterm_ostream stream(buffer);
+    stream << data::detail::remove_index_impl;
+    write(stream);
+  }
+  return buffer.str();
+}
+
+} // namespace detail
+
+using namespace detail;
+
+clts_reader::clts_reader(const std::string& filename)
+  : m_file(filename),
+    m_header(detail::read_header(m_file.data(), m_file.size()))
+{}
+
+bool clts_reader::has_state_labels() const
+{
+  return (m_header.flags & clts_has_state_labels) != 0;
+}
+
+clts_block_info clts_reader::block_info(std::size_t block) const
+{
+  assert(block < m_header.num_blocks);
+  const std::uint8_t* input = m_file.data() + m_header.index_offset + block * clts_block_info_size;
+
+  clts_block_info info;
+  info.first_state = get_uint64(input);
+  info.offset = get_uint64(input);
+  info.stored_size = get_uint32(input);
+  info.raw_size = get_uint32(input);
+  info.num_transitions = get_uint32(input);
+  info.compressed = get_uint32(input);
+
+  if (info.offset > m_file.size() || info.stored_size > m_file.size() - info.offset)
+  {
+    throw mcrl2::runtime_error("The .clts file is truncated or corrupt.");
+  }
+  return info;
+}
+
+void clts_reader::read_header(lts_lts_t& lts) const
+{
+  utilities::memory_streambuf buffer(m_file.data() + m_header.metadata_offset, m_header.metadata_size);
+  std::istream input(&buffer);
+  atermpp::binary_aterm_istream stream(input);
+  stream >> data::detail::add_index_impl;
+
+  data::data_specification spec;
+  data::variable_list parameters;
+  process::action_label_list action_label_declarations;
+  stream >> spec;
+  stream >> parameters;
+  stream >> action_label_declarations;
+
+  lts.set_data(spec);
+  lts.set_process_parameters(parameters);
+  lts.set_action_label_declarations(action_label_declarations);
+
+  // The tau action is always the first action label and is not stored.
+  lts.set_num_action_labels(m_header.num_action_labels);
+  for (std::size_t i = 1; i < m_header.num_action_labels; ++i)
+  {
+    action_label_lts action;
+    stream >> action;
+    lts.set_action_label(i, action);
+  }
+
+  lts.set_num_states(m_header.num_states, false);
+  if (m_header.num_states > 0)
+  {
+    lts.set_initial_state(m_header.initial_state);
+  }
+}
+
+void clts_reader::read_state_labels(std::vector<state_label_lts>& labels) const
+{
+  if (!has_state_labels())
+  {
+    return;
+  }
+
+  utilities::memory_streambuf buffer(m_file.data() + m_header.state_labels_offset, m_header.state_labels_size);
+  std::istream input(&buffer);
+  atermpp::binary_aterm_istream stream(input);
+  stream >> data::detail::add_index_impl;
+
+  labels.reserve(labels.size() + m_header.num_states);
+  for (std::size_t i = 0; i < m_header.num_states; ++i)
+  {
+    atermpp::aterm term;
+    stream.get(term);
+    if (!term.defined() || !term.type_is_list())
+    {
+      throw mcrl2::runtime_error("The state labels in the .clts file are corrupt.");
+    }
+    labels.push_back(reinterpret_cast<const state_label_lts&>(term));
+  }
+}
+
+void clts_reader::read_block(std::size_t block, std::vector<transition>& result) const
+{
+  const clts_block_info info = block_info(block);
+  const std::uint8_t* stored = m_file.data() + info.offset;
+
+  if (info.compressed == 0)
+  {
+    decode_block(stored, info.stored_size, info, m_header.num_states, m_header.num_action_labels, result);
+  }
+  else
+  {
+    static thread_local std::vector<std::uint8_t> raw;
+    raw.resize(info.raw_size);
+    utilities::block_decompress(stored, info.stored_size, raw.data(), raw.size());
+    decode_block(raw.data(), raw.size(), info, m_header.num_states, m_header.num_action_labels, result);
+  }
+}
+
+void clts_reader::outgoing_transitions(std::size_t state, std::vector<transition>& result) const
+{
+  // Find the first block that starts at or after state, its predecessor can contain transitions of state as well.
+  std::size_t low = 0;
+  std::size_t high = m_header.num_blocks;
+  while (low < high)
+  {
+    const std::size_t middle = low + (high - low) / 2;
+    if (block_info(middle).first_state < state)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  std::vector<transition> block_transitions;
+  for (std::size_t block = (low > 0 ? low - 1 : 0);
+       block < m_header.num_blocks && block_info(block).first_state <= state;
+       ++block)
+  {
+    block_transitions.clear();
+    read_block(block, block_transitions);
+    for (const transition& t : block_transitions)
+    {
+      if (t.from() == state)
+      {
+        result.push_back(t);
+      }
+    }
+  }
+}
+
+bool is_clts_file(const std::string& filename)
+{
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  char signature[sizeof(clts_magic)];
+  if (!stream.read(signature, sizeof(signature)))
+  {
+    return false;
+  }
+  return std::memcmp(signature, clts_magic, sizeof(clts_magic)) == 0;
+}
+
+void save_clts(const lts_lts_t& lts, const std::string& filename, bool compress, std::size_t block_size)
+{
+  if (filename.empty())
+  {
+    throw mcrl2::runtime_error("An lts in .clts format cannot be written to standard output.");
+  }
+  if (block_size == 0 || block_size > std::numeric_limits<std::uint32_t>::max())
+  {
+    throw mcrl2::runtime_error("Invalid block size " + std::to_string(block_size) + " for the .clts format.");
+  }
+
+  mCRL2log(log::verbose) << "Starting to save an lts in .clts format to the file " << filename << ".\n";
+
+  const std::string metadata = write_aterm_section([&](atermpp::aterm_ostream& stream)
+    {
+      stream << lts.data();
+      stream << lts.process_parameters();
+      stream << lts.action_label_declarations();
+      for (std::size_t i = 1; i < lts.num_action_labels(); ++i)
+      {
+        stream << lts.action_label(i);
+      }
+    });
+
+  std::string state_labels;
+  if (lts.has_state_info())
+  {
+    state_labels = write_aterm_section([&](atermpp::aterm_ostream& stream)
+      {
+        for (std::size_t i = 0; i < lts.num_states(); ++i)
+        {
+          stream << lts.state_label(i);
+        }
+      });
+  }
+
+  std::ofstream stream(filename, std::ofstream::out | std::ofstream::binary);
+  if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " for writing.");
+  }
+
+  clts_header header;
+  header.version = clts_version;
+  header.flags = lts.has_state_info() ? clts_has_state_labels : 0;
+  header.num_states = lts.num_states();
+  header.num_transitions = lts.num_transitions();
+  header.num_action_labels = lts.num_action_labels();
+  header.initial_state = lts.num_states() > 0 ? lts.initial_state() : 0;
+  header.metadata_offset = clts_header_size;
+  header.metadata_size = metadata.size();
+  header.state_labels_offset = header.metadata_offset + header.metadata_size;
+  header.state_labels_size = state_labels.size();
+
+  // The header is written again when the position of the index is known.
+  std::vector<std::uint8_t> output;
+  write_header(output, header);
+  write_bytes(stream, output.data(), output.size());
+  write_bytes(stream, metadata.data(), metadata.size());
+  write_bytes(stream, state_labels.data(), state_labels.size());
+
+  // Sort the transitions on their source state, to allow random access and effective delta encoding. Only
+  // their indices are sorted to avoid copying the transitions, and the blocks are written as they are produced.
+  const std::vector<transition>& transitions = lts.get_transitions();
+  std::vector<std::size_t> order(transitions.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j)
+    {
+      const transition& t = transitions[i];
+      const transition& u = transitions[j];
+      return std::make_tuple(t.from(), lts.apply_hidden_label_map(t.label()), t.to()) <
+             std::make_tuple(u.from(), lts.apply_hidden_label_map(u.label()), u.to());
+    });
+
+  std::uint64_t offset = header.state_labels_offset + header.state_labels_size;
+  std::vector<std::uint8_t> index;
+  std::vector<std::uint8_t> raw;
+  std::vector<std::uint8_t> compressed;
+  for (std::size_t first = 0; first < order.size(); first += block_size)
+  {
+    const std::size_t last = std::min(first + block_size, order.size());
+
+    raw.clear();
+    encode_block(lts, order.begin() + first, order.begin() + last, raw);
+
+    compressed.clear();
+    if (compress)
+    {
+      utilities::block_compress(raw.data(), raw.size(), compressed);
+    }
+    const bool use_compressed = compress && compressed.size() < raw.size();
+    const std::vector<std::uint8_t>& stored = use_compressed ? compressed : raw;
+    write_bytes(stream, stored.data(), stored.size());
+
+    put_uint64(index, transitions[order[first]].from());
+    put_uint64(index, offset);
+    put_uint32(index, static_cast<std::uint32_t>(stored.size()));
+    put_uint32(index, static_cast<std::uint32_t>(raw.size()));
+    put_uint32(index, static_cast<std::uint32_t>(last - first));
+    put_uint32(index, use_compressed ? 1 : 0);
+
+    offset += stored.size();
+    ++header.num_blocks;
+  }
+
+  header.index_offset = offset;
+  write_bytes(stream, index.data(), index.size());
+
+  output.clear();
+  write_header(output, header);
+  stream.seekp(0);
+  write_bytes(stream, output.data(), output.size());
+  if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Fail to write lts correctly to the file " + filename + ".");
+  }
+
+  mCRL2log(log::verbose) << "Stored " << transitions.size() << " transitions in " << header.num_blocks << " blocks of "
+                         << offset - header.state_labels_offset - header.state_labels_size << " bytes.\n";
+}
+
+void load_clts(lts_lts_t& lts, const std::string& filename)
+{
+  if (filename.empty())
+  {
+    throw mcrl2::runtime_error("An lts in .clts format cannot be read from standard input.");
+  }
+
+  mCRL2log(log::verbose) << "Starting to load an lts in .clts format from the file " << filename << ".\n";
+
+  clts_reader reader(filename);
+  lts.clear();
+  reader.read_header(lts);
+
+  if (reader.has_state_labels())
+  {
+    reader.read_state_labels(lts.state_labels());
+  }
+
+  std::vector<transition>& transitions = lts.get_transitions();
+  transitions.reserve(reader.num_transitions());
+  for (std::size_t block = 0; block < reader.num_blocks(); ++block)
+  {
+    reader.read_block(block, transitions);
+  }
+
+  if (transitions.size() != reader.num_transitions())
+  {
+    throw mcrl2::runtime_error("The number of transitions in the .clts file " + filename + " is incorrect.");
+  }
+}
+
+} // namespace mcrl2::lts
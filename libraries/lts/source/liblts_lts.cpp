@@ -9,7 +9,9 @@
 /// \file liblts_lts.cpp
 
 #include "mcrl2/lts/lts_lts.h"
+#include "mcrl2/lts/lts_clts.h"
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
 
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
 
@@ -302,6 +304,22 @@ static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filenam
                 std::is_same<LTS_TRANSITION_SYSTEM,lts_lts_t>::value,
                 "Function read_from_lts can only be applied to a (probabilistic) lts. ");
 
+  // Files in the columnar .clts format can be read wherever an .lts file is expected.
+  if (!filename.empty() && is_clts_file(filename))
+  {
+    if constexpr (std::is_same<LTS_TRANSITION_SYSTEM, probabilistic_lts_lts_t>::value)
+    {
+      lts_lts_t plain_lts;
+      load_clts(plain_lts, filename);
+      translate_to_probabilistic_lts(plain_lts, lts);
+    }
+    else
+    {
+      load_clts(lts, filename);
+    }
+    return;
+  }
+
   std::ifstream fstream;
   if (!filename.empty())
   {
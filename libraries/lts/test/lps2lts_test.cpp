@@ -658,3 +658,86 @@ BOOST_AUTO_TEST_CASE(test_whether_action_a_b_and_b_a_are_the_same)   // Related
 }
 
 
+
+static void check_partial_order_reduction(const std::string& specification,
+                                          const std::set<core::identifier_string>& visible_actions,
+                                          const std::size_t expected_states,
+                                          const std::size_t expected_transitions)
+{
+  lps::stochastic_specification stochastic_lpsspec;
+  parse_lps(specification, stochastic_lpsspec);
+  lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
+  for (lps::exploration_strategy estrategy: { lps::es_breadth, lps::es_depth })
+  {
+    lps::explorer_options options;
+    options.trace_prefix = "lps2lts_test";
+    options.search_strategy = estrategy;
+    options.save_at_end = true;
+    options.partial_order_reduction = true;
+    options.visible_actions = visible_actions;
+
+    lts::lts_aut_t result;
+    std::string outputfile = "test_partial_order_reduction.generatelts.aut";
+    auto builder = create_lts_builder(lpsspec, options, result.type());
+    generate_state_space<false, false>(lpsspec, *builder, outputfile, options);
+    result.load(outputfile);
+    BOOST_CHECK_EQUAL(result.num_states(), expected_states);
+    BOOST_CHECK_EQUAL(result.num_transitions(), expected_transitions);
+    std::remove(outputfile.c_str());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_partial_order_reduction)
+{
+  std::string spec(
+    "act  a,b,c: Nat;\n"
+    "\n"
+    "proc P(n,m,k: Nat) =\n"
+    "       (n < 6) ->\n"
+    "         a(n) .\n"
+    "         P(n = n + 1)\n"
+    "     + (m < 6) ->\n"
+    "         b(m) .\n"
+    "         P(m = m + 1)\n"
+    "     + (k < 6) ->\n"
+    "         c(k) .\n"
+    "         P(k = k + 1)\n"
+    "     + delta;\n"
+    "\n"
+    "init P(0, 0, 0);\n"
+  );
+  check_lps2lts_specification(spec, 343, 882, 19);
+
+  // Only the interleavings that lead to the deadlock in state (6,6,6) remain.
+  check_partial_order_reduction(spec, {}, 19, 18);
+
+  // The occurrences of b and c are preserved up to stuttering, and the a's can be postponed.
+  check_partial_order_reduction(spec, { core::identifier_string("b"), core::identifier_string("c") }, 55, 90);
+}
+
+// The conditions of all summands constrain the parameter s, using disjunctions and if-then-else.
+BOOST_AUTO_TEST_CASE(test_guard_index)
+{
+  std::string spec(
+    "act  a,c: Pos;\n"
+    "     d: Nat;\n"
+    "\n"
+    "proc P(s: Pos, b: Bool, n: Nat) =\n"
+    "       (s == 1 || s == 2) ->\n"
+    "         a(s) .\n"
+    "         P(s = s + 1)\n"
+    "     + (if(b, s == 3, s == 4)) ->\n"
+    "         c(s) .\n"
+    "         P(s = 4, b = !b)\n"
+    "     + (!b && s == 4 && n < 2) ->\n"
+    "         d(n) .\n"
+    "         P(s = 1, n = n + 1)\n"
+    "     + (b && s == 5) ->\n"
+    "         d(n) .\n"
+    "         P(s = 1)\n"
+    "     + delta;\n"
+    "\n"
+    "init P(1, true, 0);\n"
+  );
+  check_lps2lts_specification(spec, 8, 7, 6);
+}
@@ -0,0 +1,192 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lts_clts_test.cpp
+/// \brief Tests for reading and writing the columnar .clts format.
+
+#define BOOST_TEST_MODULE lts_clts_test
+#include <boost/test/included/unit_test.hpp>
+
+#include "mcrl2/data/nat.h"
+#include "mcrl2/lts/lts_clts.h"
+#include "mcrl2/lts/lts_utilities.h"
+
+#include <cstdio>
+
+using namespace mcrl2;
+
+static lts::action_label_lts make_action(const std::string& name)
+{
+  const process::action_label label{core::identifier_string(name), data::sort_expression_list()};
+  const process::action a(label, data::data_expression_list());
+  return lts::action_label_lts(lps::multi_action(process::action_list({ a })));
+}
+
+/// \brief Generates an lts with the given number of states and pseudo random transitions.
+static lts::lts_lts_t make_lts(std::size_t num_states, bool with_state_labels)
+{
+  lts::lts_lts_t l;
+  l.add_action(make_action("a"));
+  l.add_action(make_action("b"));
+  l.add_action(make_action("c"));
+
+  for (std::size_t i = 0; i < num_states; ++i)
+  {
+    if (with_state_labels)
+    {
+      l.add_state(lts::state_label_lts(std::vector<data::data_expression>{ data::sort_nat::nat(i) }));
+    }
+    else
+    {
+      l.add_state();
+    }
+  }
+
+  std::size_t seed = 1;
+  for (std::size_t i = 0; i < num_states; ++i)
+  {
+    for (std::size_t j = 0; j < i % 4; ++j)
+    {
+      seed = (seed * 1103515245 + 12345) % 2147483648;
+      l.add_transition(lts::transition(i, seed % l.num_action_labels(), seed % num_states));
+    }
+  }
+  l.set_initial_state(num_states / 2);
+  return l;
+}
+
+static std::vector<lts::transition> sorted_transitions(const lts::lts_lts_t& l)
+{
+  std::vector<lts::transition> result = l.get_transitions();
+  lts::sort_transitions(result);
+  return result;
+}
+
+static void check_equal(const lts::lts_lts_t& expected, const lts::lts_lts_t& actual)
+{
+  BOOST_CHECK_EQUAL(expected.num_states(), actual.num_states());
+  BOOST_CHECK_EQUAL(expected.initial_state(), actual.initial_state());
+  BOOST_CHECK(expected.action_labels() == actual.action_labels());
+  BOOST_CHECK(expected.state_labels() == actual.state_labels());
+  BOOST_CHECK(expected.data() == actual.data());
+  BOOST_CHECK(sorted_transitions(expected) == sorted_transitions(actual));
+}
+
+BOOST_AUTO_TEST_CASE(test_roundtrip)
+{
+  const std::string filename = "lts_clts_test_roundtrip.clts";
+  for (bool compress : { true, false })
+  {
+    for (std::size_t block_size : { std::size_t(1), std::size_t(7), lts::clts_default_block_size })
+    {
+      lts::lts_lts_t l = make_lts(200, true);
+      lts::save_clts(l, filename, compress, block_size);
+      BOOST_CHECK(lts::is_clts_file(filename));
+
+      lts::lts_lts_t result;
+      lts::load_clts(result, filename);
+      check_equal(l, result);
+
+      // The .clts format is also recognised when loading an .lts file.
+      lts::lts_lts_t loaded;
+      loaded.load(filename);
+      check_equal(l, loaded);
+    }
+  }
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_without_state_labels)
+{
+  const std::string filename = "lts_clts_test_no_labels.clts";
+  lts::lts_lts_t l = make_lts(1000, false);
+  lts::save_clts(l, filename);
+
+  lts::lts_lts_t result;
+  lts::load_clts(result, filename);
+  BOOST_CHECK(!result.has_state_info());
+  check_equal(l, result);
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_hidden_labels)
+{
+  const std::string filename = "lts_clts_test_hidden.clts";
+  lts::lts_lts_t l = make_lts(50, false);
+  l.set_hidden_label_set({ 1 });
+  lts::save_clts(l, filename);
+
+  lts::lts_lts_t result;
+  lts::load_clts(result, filename);
+  for (const lts::transition& t : result.get_transitions())
+  {
+    BOOST_CHECK(t.label() != 1);
+  }
+  BOOST_CHECK_EQUAL(l.num_transitions(), result.num_transitions());
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_random_access)
+{
+  const std::string filename = "lts_clts_test_random_access.clts";
+  lts::lts_lts_t l = make_lts(500, false);
+  lts::save_clts(l, filename, true, 5);
+
+  lts::clts_reader reader(filename);
+  BOOST_CHECK_EQUAL(reader.num_states(), l.num_states());
+  BOOST_CHECK_EQUAL(reader.num_transitions(), l.num_transitions());
+
+  const std::vector<lts::transition> transitions = sorted_transitions(l);
+  for (std::size_t state = 0; state < l.num_states(); ++state)
+  {
+    std::vector<lts::transition> expected;
+    std::copy_if(transitions.begin(), transitions.end(), std::back_inserter(expected),
+                 [state](const lts::transition& t) { return t.from() == state; });
+
+    std::vector<lts::transition> outgoing;
+    reader.outgoing_transitions(state, outgoing);
+    BOOST_CHECK(expected == outgoing);
+  }
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_file)
+{
+  const std::string filename = "lts_clts_test_invalid.clts";
+  {
+    std::ofstream stream(filename, std::ofstream::binary);
+    stream << "this is not a clts file";
+  }
+  BOOST_CHECK(!lts::is_clts_file(filename));
+
+  lts::lts_lts_t l;
+  BOOST_CHECK_THROW(lts::load_clts(l, filename), mcrl2::runtime_error);
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupt_header)
+{
+  const std::string filename = "lts_clts_test_corrupt_header.clts";
+  lts::lts_lts_t l = make_lts(100, false);
+
+  // Overwrite the number of blocks, and subsequently the offset of the index, by a huge number.
+  for (std::size_t position : { std::size_t(48), std::size_t(88) })
+  {
+    lts::save_clts(l, filename);
+    {
+      std::fstream stream(filename, std::fstream::in | std::fstream::out | std::fstream::binary);
+      stream.seekp(position);
+      const std::string huge(8, '\xff');
+      stream.write(huge.data(), huge.size());
+    }
+
+    lts::lts_lts_t result;
+    BOOST_CHECK_THROW(lts::load_clts(result, filename), mcrl2::runtime_error);
+  }
+  std::remove(filename.c_str());
+}
@@ -93,6 +93,9 @@ static void reduce_lts_in_various_ways(const std::string& test_description,
   reduce(l,lts::lts_eq_branching_bisim_sigref);
   test_lts(test_description + " (branching bisimulation signature [Blom/Orzan 2003])",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation);
   l=l_in;
+  reduce(l,lts::lts_eq_branching_bisim_par,4);
+  test_lts(test_description + " (branching bisimulation multi-threaded signature)",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation);
+  l=l_in;
   reduce(l,lts::lts_eq_divergence_preserving_branching_bisim);
   test_lts(test_description + " (divergence-preserving branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l,
                                       expected.labels_divergence_preserving_branching_bisimulation,
@@ -117,6 +120,12 @@ static void reduce_lts_in_various_ways(const std::string& test_description,
                                       expected.states_divergence_preserving_branching_bisimulation,
                                       expected.transitions_divergence_preserving_branching_bisimulation);
   l=l_in;
+  reduce(l,lts::lts_eq_divergence_preserving_branching_bisim_par,4);
+  test_lts(test_description + " (divergence-preserving branching bisimulation multi-threaded signature)",l,
+                                      expected.labels_divergence_preserving_branching_bisimulation,
+                                      expected.states_divergence_preserving_branching_bisimulation,
+                                      expected.transitions_divergence_preserving_branching_bisimulation);
+  l=l_in;
   reduce(l,lts::lts_eq_weak_bisim);
   test_lts(test_description + " (weak bisimulation)",l, expected.labels_weak_bisimulation,expected.states_weak_bisimulation, expected.transitions_weak_bisimulation);
   l=l_in;
@@ -447,6 +456,39 @@ BOOST_AUTO_TEST_CASE(test_reachability)
   BOOST_CHECK(reachability_check(l_reach,false));
 }
 
+BOOST_AUTO_TEST_CASE(test_relayout)
+{
+  std::string RELAYOUT =
+    "des (3,6,6)       \n"
+    "(3,\"a\",5)\n"
+    "(5,\"b\",0)\n"
+    "(0,\"c\",1)\n"
+    "(1,\"a\",1)\n"
+    "(1,\"tau\",3)\n"
+    "(4,\"a\",2)\n"
+    ;
+
+  std::istringstream is(RELAYOUT);
+  lts::lts_aut_t l;
+  l.load(is);
+  const lts::lts_aut_t original = l;
+  const std::vector<std::size_t> new_number = relayout(l);
+
+  // States are numbered in breadth-first order, followed by the unreachable states.
+  const std::vector<std::size_t> expected = { 2, 3, 4, 0, 5, 1 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(new_number.begin(), new_number.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(l.initial_state(), 0u);
+  BOOST_CHECK_EQUAL(l.num_states(), original.num_states());
+  BOOST_CHECK_EQUAL(l.num_transitions(), original.num_transitions());
+  BOOST_CHECK(std::is_sorted(l.get_transitions().begin(), l.get_transitions().end()));
+  for (const lts::transition& t: original.get_transitions())
+  {
+    const lts::transition renumbered(new_number[t.from()], t.label(), new_number[t.to()]);
+    BOOST_CHECK(std::find(l.get_transitions().begin(), l.get_transitions().end(), renumbered) != l.get_transitions().end());
+  }
+  BOOST_CHECK(compare(l, original, lts::lts_eq_bisim));
+}
+
 // The example below caused failures in the GW mlogn branching bisimulation
 // algorithm when cleaning the code up.
 BOOST_AUTO_TEST_CASE(failing_test_groote_wijs_algorithm)
@@ -936,3 +978,165 @@ BOOST_AUTO_TEST_CASE(hide_actions4)
   test_lts("regression test for GJKW bug (branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l,expected_label_count, expected_state_count, expected_transition_count);
 }
 
+
+// Check that the simulation preorder does not depend on the number of threads
+// that is used to compute it. The lts is large enough to have more blocks than
+// the threshold above which the relations are updated in parallel.
+BOOST_AUTO_TEST_CASE(parallel_simulation_preorder)
+{
+  const std::size_t num_states = 1500;
+  lts::lts_aut_t l;
+  l.add_action(lts::action_label_string("a"));
+  l.add_action(lts::action_label_string("b"));
+  l.add_action(lts::action_label_string("c"));
+  l.set_num_states(num_states);
+  for (std::size_t i = 0; i + 1 < num_states; ++i)
+  {
+    l.add_transition(lts::transition(i, 1 + i % 2, i + 1));
+    if (i % 3 == 0)
+    {
+      l.add_transition(lts::transition(i, 1 + (i / 3) % 3 % 2, (i * 7) % num_states));
+    }
+  }
+  l.set_initial_state(0);
+
+  lts::lts_aut_t l_sequential = l;
+  lts::detail::sim_partitioner<lts::lts_aut_t> sequential(l_sequential, 1);
+  sequential.partitioning_algorithm();
+
+  lts::lts_aut_t l_parallel = l;
+  lts::detail::sim_partitioner<lts::lts_aut_t> parallel(l_parallel, 4);
+  parallel.partitioning_algorithm();
+
+  BOOST_CHECK_GT(sequential.num_eq_classes(), 512u);
+  BOOST_CHECK_EQUAL(sequential.num_eq_classes(), parallel.num_eq_classes());
+  for (std::size_t s = 0; s < num_states; ++s)
+  {
+    BOOST_CHECK_EQUAL(sequential.get_eq_class(s), parallel.get_eq_class(s));
+    for (std::size_t t = 0; t < num_states; t += 37)
+    {
+      BOOST_CHECK_EQUAL(sequential.in_preorder(s, t), parallel.in_preorder(s, t));
+    }
+  }
+  BOOST_CHECK(sequential.get_transitions() == parallel.get_transitions());
+}
+
+// Check that the tau loops found by the parallel scc partitioner coincide with those
+// of the sequential one. The lts contains tau cycles of different lengths, tau chains
+// leading into and out of these cycles and a long tau chain, which must not exhaust
+// the stack of the sequential algorithm.
+BOOST_AUTO_TEST_CASE(parallel_scc_partitioning)
+{
+  const std::size_t num_cycle_states = 3000;
+  const std::size_t chain_length = 200000;
+  lts::lts_aut_t l;
+  l.add_action(lts::action_label_string("a"));
+  l.set_num_states(num_cycle_states + chain_length);
+  for (std::size_t i = 0; i < num_cycle_states; ++i)
+  {
+    // States i with i % 10 < 7 lie on a cycle of length 7 within their group of ten states.
+    const std::size_t group = i - i % 10;
+    if (i % 10 < 7)
+    {
+      l.add_transition(lts::transition(i, 0, group + (i % 10 + 1) % 7));
+    }
+    else
+    {
+      l.add_transition(lts::transition(i, 0, (i * 13) % num_cycle_states));
+    }
+    l.add_transition(lts::transition(i, 1, (i * 7) % num_cycle_states));
+    if (i % 50 == 0)
+    {
+      // Connect groups, occasionally forming a larger component.
+      l.add_transition(lts::transition(i, 0, (i + 10) % num_cycle_states));
+    }
+  }
+  for (std::size_t i = num_cycle_states; i + 1 < num_cycle_states + chain_length; ++i)
+  {
+    l.add_transition(lts::transition(i, 0, i + 1));
+  }
+  l.add_transition(lts::transition(num_cycle_states + chain_length - 1, 0, 0));
+  l.set_initial_state(0);
+
+  lts::detail::scc_partitioner<lts::lts_aut_t> sequential(l, 1);
+  lts::detail::scc_partitioner<lts::lts_aut_t> parallel(l, 4);
+
+  BOOST_CHECK_EQUAL(sequential.num_eq_classes(), parallel.num_eq_classes());
+  std::vector<std::size_t> sequential_to_parallel(sequential.num_eq_classes(), l.num_states());
+  for (std::size_t s = 0; s < l.num_states(); ++s)
+  {
+    std::size_t& c = sequential_to_parallel[sequential.get_eq_class(s)];
+    if (c == l.num_states())
+    {
+      c = parallel.get_eq_class(s);
+    }
+    BOOST_CHECK_EQUAL(c, parallel.get_eq_class(s));
+  }
+  std::sort(sequential_to_parallel.begin(), sequential_to_parallel.end());
+  BOOST_CHECK(std::adjacent_find(sequential_to_parallel.begin(), sequential_to_parallel.end()) == sequential_to_parallel.end());
+
+  lts::lts_aut_t l_sequential = l;
+  lts::lts_aut_t l_parallel = l;
+  lts::scc_reduce(l_sequential, false, 1);
+  lts::scc_reduce(l_parallel, false, 4);
+  BOOST_CHECK_EQUAL(l_sequential.num_states(), l_parallel.num_states());
+  BOOST_CHECK_EQUAL(l_sequential.num_transitions(), l_parallel.num_transitions());
+}
+
+// Check the multi-threaded branching bisimulation algorithm against the sequential
+// O(m log n) algorithm on pseudo-randomly generated transition systems.
+BOOST_AUTO_TEST_CASE(parallel_branching_bisimulation)
+{
+  std::size_t seed = 12345;
+  auto next_random = [&seed](std::size_t bound)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (seed >> 33) % bound;
+  };
+
+  for (std::size_t round = 0; round < 20; ++round)
+  {
+    const std::size_t num_states = 50 + next_random(2000);
+    lts::lts_aut_t l;
+    l.add_action(lts::action_label_string("a"));
+    l.add_action(lts::action_label_string("b"));
+    l.set_num_states(num_states);
+    const std::size_t num_transitions = num_states + next_random(2 * num_states);
+    for (std::size_t i = 0; i < num_transitions; ++i)
+    {
+      // Transitions mostly go to nearby states, to obtain tau loops as well as long tau paths.
+      const std::size_t from = next_random(num_states);
+      const std::size_t to = next_random(4) == 0 ? next_random(num_states) : (from + next_random(5)) % num_states;
+      l.add_transition(lts::transition(from, next_random(3), to));
+    }
+    l.set_initial_state(0);
+
+    for (const bool preserve_divergence: { false, true })
+    {
+      lts::lts_aut_t l_sequential = l;
+      lts::lts_aut_t l_parallel = l;
+      lts::detail::bisimulation_reduce_dnj(l_sequential, true, preserve_divergence);
+      lts::detail::bisimulation_reduce_par(l_parallel, true, preserve_divergence, 4);
+      BOOST_CHECK_EQUAL(l_sequential.num_states(), l_parallel.num_states());
+      BOOST_CHECK_EQUAL(l_sequential.num_transitions(), l_parallel.num_transitions());
+      BOOST_CHECK(lts::compare(l_sequential, l_parallel, lts::lts_eq_bisim));
+
+      // The partition itself does not depend on the number of threads.
+      lts::lts_aut_t l_without_tau_loops = l;
+      lts::scc_reduce(l_without_tau_loops, preserve_divergence);
+      lts::detail::bisim_partitioner_parallel<lts::lts_aut_t> single_thread(l_without_tau_loops, true, preserve_divergence, 1);
+      lts::detail::bisim_partitioner_parallel<lts::lts_aut_t> multiple_threads(l_without_tau_loops, true, preserve_divergence, 4);
+      BOOST_CHECK_EQUAL(single_thread.num_eq_classes(), l_parallel.num_states());
+      for (std::size_t s = 0; s < l_without_tau_loops.num_states(); ++s)
+      {
+        BOOST_CHECK_EQUAL(single_thread.get_eq_class(s), multiple_threads.get_eq_class(s));
+      }
+    }
+
+    lts::lts_aut_t l1 = l;
+    lts::lts_aut_t l2 = l;
+    l2.set_initial_state(num_states - 1);
+    BOOST_CHECK_EQUAL(lts::compare(l1, l2, lts::lts_eq_branching_bisim),
+                      lts::compare(l1, l2, lts::lts_eq_branching_bisim_par, false, "", false, 4));
+  }
+}
@@ -9,6 +9,7 @@
 /// \file mcrl2/pbes/pbesinst_lazy_algorithm.h
 /// \brief A lazy algorithm for instantiating a PBES, ported from bes_deprecated.h.
 
+#include <condition_variable>
 #include <thread>
 #include <mutex>
 
@@ -205,6 +206,15 @@ class pbesinst_lazy_algorithm
     // Mutexes
     utilities::mutex m_todo_access;
 
+    /// \brief Wakes up threads that wait for work when the todo set is extended or the instantiation has finished.
+    std::condition_variable_any m_todo_changed;
+
+    /// \brief The number of threads that wait for work. Protected by m_todo_access.
+    std::size_t m_number_of_idle_threads = 0;
+
+    /// \brief Indicates that all threads must stop. Protected by m_todo_access.
+    bool m_finished = false;
+
     volatile bool m_must_abort = false;
 
     // \brief Returns a status message about the progress
@@ -364,7 +374,6 @@ class pbesinst_lazy_algorithm
 
     virtual void run_thread(const std::size_t thread_index,
                             pbesinst_lazy_todo& todo,
-                            std::atomic<std::size_t>& number_of_active_processes,
                             data::mutable_indexed_substitution<> sigma,
                             enumerate_quantifiers_rewriter R
                            )
@@ -377,64 +386,70 @@ class pbesinst_lazy_algorithm
       propositional_variable_instantiation X_e;
       pbes_expression psi_e;
 
-      while (number_of_active_processes > 0)
+      std::unique_lock<utilities::mutex> lock(m_todo_access);
+      while (!m_finished)
       {
-        m_todo_access.lock();
-        while (!todo.elements().empty() && !m_must_abort)
+        if (todo.elements().empty() || m_must_abort)
         {
-          ++m_iteration_count;
-          mCRL2log(log::status) << status_message(m_iteration_count);
-          detail::check_bes_equation_limit(m_iteration_count);
-
-          next_todo(X_e);
-          m_todo_access.unlock();
-
-          std::size_t index = m_equation_index.index(X_e.name());
-          const pbes_equation& eqn = m_pbes.equations()[index];
-          const auto& phi = eqn.formula();
-          data::add_assignments(sigma, eqn.variable().parameters(), X_e.parameters());
-          R(psi_e, phi, sigma);
-          R.clear_identifier_generator();
-          data::remove_assignments(sigma, eqn.variable().parameters());
-
-          // optional step
-          m_todo_access.lock();
-          rewrite_psi(thread_index, psi_e, eqn.symbol(), X_e, psi_e);
-          m_todo_access.unlock();
-
-          std::set<propositional_variable_instantiation> occ = find_propositional_variable_instantiations(psi_e);
-
-          // report the generated equation
-          std::size_t k = m_equation_index.rank(X_e.name());
-          m_todo_access.lock();
-          mCRL2log(log::debug) << "generated equation " << X_e << " = " << psi_e
-                               << " with rank " << k << std::endl;
-          on_report_equation(thread_index, X_e, psi_e, k);
-          todo.insert(occ.begin(), occ.end(), discovered, thread_index);
-          for (auto i = occ.begin(); i != occ.end(); ++i)
-          {
-            discovered.insert(*i, thread_index);
-          }
-          on_discovered_elements(occ);
-
-          if (solution_found(init))
+          // New work can only be generated by a thread that is not idle. So if all
+          // threads are idle, the instantiation is finished.
+          if (++m_number_of_idle_threads == m_options.number_of_threads || m_must_abort)
           {
+            m_finished = true;
+            m_todo_changed.notify_all();
             break;
           }
+          m_todo_changed.wait(lock, [&]() { return m_finished || m_must_abort || !todo.elements().empty(); });
+          --m_number_of_idle_threads;
+          continue;
+        }
+
+        ++m_iteration_count;
+        mCRL2log(log::status) << status_message(m_iteration_count);
+        detail::check_bes_equation_limit(m_iteration_count);
+
+        next_todo(X_e);
+        lock.unlock();
+
+        std::size_t index = m_equation_index.index(X_e.name());
+        const pbes_equation& eqn = m_pbes.equations()[index];
+        const auto& phi = eqn.formula();
+        data::add_assignments(sigma, eqn.variable().parameters(), X_e.parameters());
+        R(psi_e, phi, sigma);
+        R.clear_identifier_generator();
+        data::remove_assignments(sigma, eqn.variable().parameters());
+
+        // optional step
+        lock.lock();
+        rewrite_psi(thread_index, psi_e, eqn.symbol(), X_e, psi_e);
+        lock.unlock();
+
+        std::set<propositional_variable_instantiation> occ = find_propositional_variable_instantiations(psi_e);
+
+        // report the generated equation
+        std::size_t k = m_equation_index.rank(X_e.name());
+        lock.lock();
+        mCRL2log(log::debug) << "generated equation " << X_e << " = " << psi_e
+                             << " with rank " << k << std::endl;
+        on_report_equation(thread_index, X_e, psi_e, k);
+        todo.insert(occ.begin(), occ.end(), discovered, thread_index);
+        for (auto i = occ.begin(); i != occ.end(); ++i)
+        {
+          discovered.insert(*i, thread_index);
+        }
+        on_discovered_elements(occ);
+
+        if (solution_found(init))
+        {
+          m_finished = true;
+          m_todo_changed.notify_all();
         }
-        m_todo_access.unlock();
-
-        // Check whether all processes are ready. If so the
-        // number_of_active_processes becomes 0. Otherwise, this thread becomes
-        // active again, and tries to see whether the todo buffer is not empty,
-        // to take up more work.
-        number_of_active_processes--;
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        if (number_of_active_processes > 0)
+        else if (m_number_of_idle_threads > 0 && !todo.elements().empty())
         {
-          number_of_active_processes++;
+          m_todo_changed.notify_all();
         }
       }
+      lock.unlock();
 
       if (m_options.number_of_threads>1) mCRL2log(log::debug) << "Stop thread " << thread_index << ".\n";
     }
@@ -446,8 +461,9 @@ class pbesinst_lazy_algorithm
 
       const std::size_t number_of_threads = m_options.number_of_threads;
       const std::size_t initialisation_thread_index = (number_of_threads==1?0:1);
-      std::atomic<std::size_t> number_of_active_processes = number_of_threads;
       std::vector<std::thread> threads;
+      m_number_of_idle_threads = 0;
+      m_finished = false;
 
       data::mutable_indexed_substitution<> sigma;
       if (m_options.replace_constants_by_variables)
@@ -467,7 +483,6 @@ class pbesinst_lazy_algorithm
           std::thread tr([&, i](){
             run_thread(i,
                        todo,
-                       number_of_active_processes,
                        sigma.clone(),
                        m_global_R.clone()
                       );
@@ -486,7 +501,6 @@ class pbesinst_lazy_algorithm
         const std::size_t single_thread_index=0;
         run_thread(single_thread_index,
                    todo,
-                   number_of_active_processes,
                    sigma,
                    m_global_R
                   );
@@ -0,0 +1,235 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/block_compression.h
+/// \brief A small LZ77 style compressor for blocks of binary data.
+
+#ifndef MCRL2_UTILITIES_BLOCK_COMPRESSION_H
+#define MCRL2_UTILITIES_BLOCK_COMPRESSION_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "mcrl2/utilities/exception.h"
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+namespace detail
+{
+
+/// \brief The minimal length of a match that is worth encoding as a back reference.
+constexpr std::size_t block_compression_min_match = 4;
+
+/// \brief The largest distance of a back reference, determined by the two byte offset encoding.
+constexpr std::size_t block_compression_max_offset = 65535;
+
+/// \brief The number of bits used to hash a sequence of four bytes.
+constexpr std::size_t block_compression_hash_bits = 14;
+
+inline std::uint32_t block_compression_read32(const std::uint8_t* p)
+{
+  std::uint32_t result;
+  std::memcpy(&result, p, sizeof(result));
+  return result;
+}
+
+inline std::size_t block_compression_hash(std::uint32_t sequence)
+{
+  return (sequence * 2654435761U) >> (32 - block_compression_hash_bits);
+}
+
+/// \brief Writes a length that did not fit in a four bit nibble as a sequence of bytes.
+inline void block_compression_write_length(std::vector<std::uint8_t>& output, std::size_t length)
+{
+  while (length >= 255)
+  {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back(static_cast<std::uint8_t>(length));
+}
+
+/// \brief Writes the literals [begin, end) and, when offset is non zero, the match (offset, length) as one sequence.
+inline void block_compression_write_sequence(std::vector<std::uint8_t>& output,
+  const std::uint8_t* begin,
+  const std::uint8_t* end,
+  std::size_t offset,
+  std::size_t match_length)
+{
+  const std::size_t literal_length = end - begin;
+  const std::size_t encoded_match = (offset == 0 ? 0 : match_length - block_compression_min_match);
+
+  output.push_back(static_cast<std::uint8_t>(((literal_length < 15 ? literal_length : 15) << 4)
+                                             | (encoded_match < 15 ? encoded_match : 15)));
+  if (literal_length >= 15)
+  {
+    block_compression_write_length(output, literal_length - 15);
+  }
+  output.insert(output.end(), begin, end);
+
+  if (offset != 0)
+  {
+    output.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+    output.push_back(static_cast<std::uint8_t>(offset >> 8));
+    if (encoded_match >= 15)
+    {
+      block_compression_write_length(output, encoded_match - 15);
+    }
+  }
+}
+
+inline std::size_t block_compression_read_length(const std::uint8_t*& input, const std::uint8_t* input_end)
+{
+  std::size_t length = 0;
+  std::uint8_t byte;
+  do
+  {
+    if (input == input_end)
+    {
+      throw mcrl2::runtime_error("Compressed block ends in the middle of a length.");
+    }
+    byte = *input++;
+    length += byte;
+  }
+  while (byte == 255);
+  return length;
+}
+
+} // namespace detail
+
+/// \brief Compresses size bytes starting at data and appends the result to output.
+/// \details The encoding is a sequence of (literals, back reference) pairs in the style of LZ4. Every
+///          sequence starts with a token byte whose upper nibble contains the number of literals and whose
+///          lower nibble contains the match length minus four. The value 15 indicates that the length
+///          continues in subsequent bytes. The back reference is a two byte little endian offset. The last
+///          sequence only consists of literals. The decompressor must know the original size.
+inline void block_compress(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& output)
+{
+  using namespace detail;
+
+  const std::uint8_t* const end = data + size;
+  const std::uint8_t* literal_begin = data;
+
+  if (size >= block_compression_min_match)
+  {
+    // The table stores for every hashed sequence of four bytes the last position (plus one) where it was seen.
+    std::vector<std::uint32_t> table(std::size_t(1) << block_compression_hash_bits, 0);
+    const std::uint8_t* const match_limit = end - block_compression_min_match;
+
+    const std::uint8_t* position = data;
+    while (position <= match_limit)
+    {
+      const std::uint32_t sequence = block_compression_read32(position);
+      std::uint32_t& entry = table[block_compression_hash(sequence)];
+      const std::uint8_t* candidate = (entry == 0 ? nullptr : data + entry - 1);
+      entry = static_cast<std::uint32_t>(position - data) + 1;
+
+      if (candidate != nullptr
+          && static_cast<std::size_t>(position - candidate) <= block_compression_max_offset
+          && block_compression_read32(candidate) == sequence)
+      {
+        // Extend the match as far as possible.
+        std::size_t length = block_compression_min_match;
+        while (position + length < end && candidate[length] == position[length])
+        {
+          ++length;
+        }
+
+        block_compression_write_sequence(output, literal_begin, position, position - candidate, length);
+        position += length;
+        literal_begin = position;
+      }
+      else
+      {
+        ++position;
+      }
+    }
+  }
+
+  // The remaining bytes are written as literals.
+  block_compression_write_sequence(output, literal_begin, end, 0, 0);
+}
+
+/// \brief Decompresses the input produced by block_compress into exactly output_size bytes at output.
+/// \details Throws a runtime error whenever the input is not a valid compressed block of the given size.
+inline void block_decompress(const std::uint8_t* input, std::size_t input_size, std::uint8_t* output, std::size_t output_size)
+{
+  using namespace detail;
+
+  const std::uint8_t* const input_end = input + input_size;
+  std::uint8_t* const output_begin = output;
+  std::uint8_t* const output_end = output + output_size;
+
+  while (input != input_end)
+  {
+    const std::uint8_t token = *input++;
+
+    std::size_t literal_length = token >> 4;
+    if (literal_length == 15)
+    {
+      literal_length += block_compression_read_length(input, input_end);
+    }
+    if (static_cast<std::size_t>(input_end - input) < literal_length
+        || static_cast<std::size_t>(output_end - output) < literal_length)
+    {
+      throw mcrl2::runtime_error("Compressed block contains too many literals.");
+    }
+    std::memcpy(output, input, literal_length);
+    input += literal_length;
+    output += literal_length;
+
+    if (input == input_end)
+    {
+      // The last sequence does not contain a back reference.
+      break;
+    }
+
+    if (input_end - input < 2)
+    {
+      throw mcrl2::runtime_error("Compressed block ends in the middle of an offset.");
+    }
+    const std::size_t offset = input[0] | (static_cast<std::size_t>(input[1]) << 8);
+    input += 2;
+
+    std::size_t match_length = token & 0x0F;
+    if (match_length == 15)
+    {
+      match_length += block_compression_read_length(input, input_end);
+    }
+    match_length += block_compression_min_match;
+
+    if (offset == 0
+        || static_cast<std::size_t>(output - output_begin) < offset
+        || static_cast<std::size_t>(output_end - output) < match_length)
+    {
+      throw mcrl2::runtime_error("Compressed block contains an invalid back reference.");
+    }
+
+    // The source and destination can overlap, which encodes a repetition, so copy byte by byte.
+    const std::uint8_t* source = output - offset;
+    for (std::size_t i = 0; i < match_length; ++i)
+    {
+      output[i] = source[i];
+    }
+    output += match_length;
+  }
+
+  if (output != output_end)
+  {
+    throw mcrl2::runtime_error("Compressed block does not have the expected size.");
+  }
+}
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_BLOCK_COMPRESSION_H
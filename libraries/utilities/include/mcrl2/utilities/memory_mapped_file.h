@@ -0,0 +1,65 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/memory_mapped_file.h
+/// \brief Read only access to the contents of a file through memory mapping.
+
+#ifndef MCRL2_UTILITIES_MEMORY_MAPPED_FILE_H
+#define MCRL2_UTILITIES_MEMORY_MAPPED_FILE_H
+
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "mcrl2/utilities/noncopyable.h"
+
+namespace mcrl2
+{
+namespace utilities
+{
+
+/// \brief Maps the contents of a file read only into memory.
+/// \details On platforms that do not support mmap the contents of the file are read into a buffer instead.
+class memory_mapped_file : private noncopyable
+{
+public:
+  /// \brief Maps the file with the given name into memory, throws a runtime_error on failure.
+  explicit memory_mapped_file(const std::string& filename);
+  ~memory_mapped_file();
+
+  /// \returns A pointer to the first byte of the file.
+  const std::uint8_t* data() const { return m_data; }
+
+  /// \returns The number of bytes in the file.
+  std::size_t size() const { return m_size; }
+
+private:
+  const std::uint8_t* m_data = nullptr;
+  std::size_t m_size = 0;
+
+  std::vector<std::uint8_t> m_buffer; ///< Only used when the file could not be mapped.
+  bool m_mapped = false;
+};
+
+/// \brief A stream buffer that reads from a fixed range of memory without copying it.
+/// \details Can be used to construct a std::istream over (a part of) a memory_mapped_file.
+class memory_streambuf : public std::streambuf
+{
+public:
+  memory_streambuf(const std::uint8_t* data, std::size_t size)
+  {
+    char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+    setg(begin, begin, begin + size);
+  }
+};
+
+} // namespace utilities
+} // namespace mcrl2
+
+#endif // MCRL2_UTILITIES_MEMORY_MAPPED_FILE_H
@@ -0,0 +1,55 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/parallel_for.h
+/// \brief Divides a range of indices over a number of threads.
+
+#ifndef MCRL2_UTILITIES_PARALLEL_FOR_H
+#define MCRL2_UTILITIES_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace mcrl2::utilities
+{
+
+/// \brief Applies f(first, last) to consecutive subranges of [0, size) using at most
+///        number_of_threads threads, of which the calling thread is one.
+/// \details The subranges are disjoint, so f may write to data that is indexed by
+///          its range without synchronisation. The function returns when all
+///          subranges have been processed. The threads are not allowed to create
+///          or destroy terms unless the toolset is compiled with thread safety.
+template <typename Function>
+void parallel_for(std::size_t size, std::size_t number_of_threads, Function f)
+{
+  number_of_threads = std::max<std::size_t>(1, std::min(number_of_threads, size));
+  if (number_of_threads == 1)
+  {
+    f(std::size_t(0), size);
+    return;
+  }
+
+  const std::size_t chunk = (size + number_of_threads - 1) / number_of_threads;
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads - 1);
+  for (std::size_t first = chunk; first < size; first += chunk)
+  {
+    threads.emplace_back(f, first, std::min(first + chunk, size));
+  }
+  f(std::size_t(0), std::min(chunk, size));
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_PARALLEL_FOR_H
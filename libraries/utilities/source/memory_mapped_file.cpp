@@ -0,0 +1,81 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/memory_mapped_file.h"
+
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/platform.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace mcrl2::utilities;
+
+memory_mapped_file::memory_mapped_file(const std::string& filename)
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+  int descriptor = ::open(filename.c_str(), O_RDONLY);
+  if (descriptor == -1)
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " for reading.");
+  }
+
+  struct stat status;
+  if (::fstat(descriptor, &status) == -1)
+  {
+    ::close(descriptor);
+    throw mcrl2::runtime_error("Fail to determine the size of file " + filename + ".");
+  }
+
+  m_size = static_cast<std::size_t>(status.st_size);
+  if (m_size > 0)
+  {
+    void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (address != MAP_FAILED)
+    {
+      m_data = static_cast<const std::uint8_t*>(address);
+      m_mapped = true;
+    }
+  }
+  ::close(descriptor);
+
+  if (m_mapped || m_size == 0)
+  {
+    return;
+  }
+#endif // MCRL2_PLATFORM_WINDOWS
+
+  // Fall back to reading the whole file into memory.
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " for reading.");
+  }
+
+  m_buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+}
+
+memory_mapped_file::~memory_mapped_file()
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+  if (m_mapped)
+  {
+    ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+  }
+#endif // MCRL2_PLATFORM_WINDOWS
+}
@@ -0,0 +1,75 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/block_compression.h"
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include <random>
+
+using namespace mcrl2::utilities;
+
+static void check_roundtrip(const std::vector<std::uint8_t>& input)
+{
+  std::vector<std::uint8_t> compressed;
+  block_compress(input.data(), input.size(), compressed);
+
+  std::vector<std::uint8_t> output(input.size());
+  block_decompress(compressed.data(), compressed.size(), output.data(), output.size());
+  BOOST_CHECK(input == output);
+}
+
+BOOST_AUTO_TEST_CASE(empty_and_small_test)
+{
+  check_roundtrip({});
+  check_roundtrip({42});
+  check_roundtrip({1, 2, 3});
+  check_roundtrip({1, 2, 3, 4, 1, 2, 3, 4});
+}
+
+BOOST_AUTO_TEST_CASE(repetitive_test)
+{
+  std::vector<std::uint8_t> input(100000, 7);
+  for (std::size_t i = 0; i < input.size(); i += 13)
+  {
+    input[i] = static_cast<std::uint8_t>(i % 5);
+  }
+  check_roundtrip(input);
+
+  std::vector<std::uint8_t> compressed;
+  block_compress(input.data(), input.size(), compressed);
+  BOOST_CHECK(compressed.size() < input.size() / 4);
+}
+
+BOOST_AUTO_TEST_CASE(random_test)
+{
+  std::mt19937 generator(1337);
+  for (std::size_t size : {15u, 16u, 255u, 270u, 4096u, 70000u})
+  {
+    std::vector<std::uint8_t> input(size);
+    for (std::uint8_t& byte : input)
+    {
+      // A small alphabet ensures that there are matches of varying lengths.
+      byte = static_cast<std::uint8_t>(generator() % 4);
+    }
+    check_roundtrip(input);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(corrupt_input_test)
+{
+  std::vector<std::uint8_t> input(1000, 3);
+  std::vector<std::uint8_t> compressed;
+  block_compress(input.data(), input.size(), compressed);
+
+  std::vector<std::uint8_t> output(input.size() + 1);
+  BOOST_CHECK_THROW(block_decompress(compressed.data(), compressed.size(), output.data(), output.size()), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(block_decompress(compressed.data(), 3, output.data(), input.size()), mcrl2::runtime_error);
+}
@@ -0,0 +1,850 @@
+// Author(s): mCRL2 developers
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file distributed_exploration.h
+/// \brief State space exploration by a number of worker processes that each own
+///        a hash partition of the state space and communicate via sockets.
+
+#ifndef MCRL2_LPS2LTS_DISTRIBUTED_EXPLORATION_H
+#define MCRL2_LPS2LTS_DISTRIBUTED_EXPLORATION_H
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "mcrl2/atermpp/aterm_int.h"
+#include "mcrl2/atermpp/standard_containers/indexed_set.h"
+#include "mcrl2/atermpp/standard_containers/vector.h"
+#include "mcrl2/data/detail/io.h"
+#include "mcrl2/lps/explorer.h"
+#include "mcrl2/lts/lts_builder.h"
+
+namespace mcrl2::lts::distributed {
+
+/// \brief A stream buffer that reads from or writes to a file descriptor, e.g., one end of a socket.
+/// \details An instance must be used either for reading or for writing.
+class fd_streambuf: public std::streambuf
+{
+  protected:
+    int m_fd;
+    std::vector<char> m_buffer;
+
+    int write_buffer()
+    {
+      const char* first = pbase();
+      while (first < pptr())
+      {
+        ssize_t n = ::write(m_fd, first, pptr() - first);
+        if (n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+        if (n <= 0)
+        {
+          return -1;
+        }
+        first += n;
+      }
+      setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+      return 0;
+    }
+
+    int_type underflow() override
+    {
+      ssize_t n;
+      do
+      {
+        n = ::read(m_fd, m_buffer.data(), m_buffer.size());
+      }
+      while (n < 0 && errno == EINTR);
+      if (n <= 0)
+      {
+        return traits_type::eof();
+      }
+      setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + n);
+      return traits_type::to_int_type(*gptr());
+    }
+
+    int_type overflow(int_type c) override
+    {
+      if (write_buffer() != 0)
+      {
+        return traits_type::eof();
+      }
+      if (!traits_type::eq_int_type(c, traits_type::eof()))
+      {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+      }
+      return traits_type::not_eof(c);
+    }
+
+    int sync() override
+    {
+      return write_buffer();
+    }
+
+  public:
+    explicit fd_streambuf(int fd, std::size_t buffer_size = 1 << 16)
+      : m_fd(fd), m_buffer(buffer_size)
+    {
+      setg(m_buffer.data(), m_buffer.data(), m_buffer.data());
+      setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    }
+};
+
+// The records of the format used by term_writer and term_reader. Every record starts with its kind, followed
+// by a number of fields. All numbers are written in a variable length encoding with seven bits per byte.
+enum class record { function_symbol, appl, integer, output, reset };
+
+/// \brief Writes terms to a file descriptor. Terms that occur in earlier terms are written as references.
+/// \details As the indices of data::function_symbols differ between processes, they are removed before
+///          writing and added by the term_reader.
+class term_writer
+{
+  protected:
+    fd_streambuf m_buffer;
+    std::ostream m_stream;
+    atermpp::indexed_set<atermpp::aterm> m_terms;
+    mcrl2::utilities::indexed_set<atermpp::function_symbol> m_function_symbols;
+
+    // To bound the memory that is used for sharing, the tables are cleared if they contain this number of terms.
+    static constexpr std::size_t max_shared_terms = 1 << 20;
+
+    void write_number(std::size_t n)
+    {
+      while (n >= 0x80)
+      {
+        m_stream.put(static_cast<char>((n & 0x7f) | 0x80));
+        n >>= 7;
+      }
+      m_stream.put(static_cast<char>(n));
+    }
+
+    std::size_t write_function_symbol(const atermpp::function_symbol& f)
+    {
+      auto [index, is_new] = m_function_symbols.insert(f);
+      if (is_new)
+      {
+        write_number(static_cast<std::size_t>(record::function_symbol));
+        write_number(f.name().size());
+        m_stream.write(f.name().data(), f.name().size());
+        write_number(f.arity());
+      }
+      return index;
+    }
+
+  public:
+    explicit term_writer(int fd)
+      : m_buffer(fd), m_stream(&m_buffer)
+    {}
+
+    void put(const atermpp::aterm& t)
+    {
+      if (m_terms.size() >= max_shared_terms)
+      {
+        write_number(static_cast<std::size_t>(record::reset));
+        m_terms.clear();
+        m_function_symbols.clear();
+      }
+
+      // Write the subterms bottom up. The boolean indicates whether the arguments are already on the stack.
+      std::vector<std::pair<atermpp::aterm, bool>> stack = { { t, false } };
+      while (!stack.empty())
+      {
+        const atermpp::aterm x = stack.back().first;
+        const bool expanded = stack.back().second;
+        if (m_terms.index(x) < m_terms.size())
+        {
+          stack.pop_back();
+        }
+        else if (x.type_is_int())
+        {
+          write_number(static_cast<std::size_t>(record::integer));
+          write_number(atermpp::down_cast<atermpp::aterm_int>(x).value());
+          m_terms.insert(x);
+          stack.pop_back();
+        }
+        else
+        {
+          const atermpp::aterm_appl y = data::detail::remove_index_impl(atermpp::down_cast<atermpp::aterm_appl>(x));
+          if (!expanded)
+          {
+            stack.back().second = true;
+            for (const atermpp::aterm& argument: y)
+            {
+              if (m_terms.index(argument) >= m_terms.size())
+              {
+                stack.emplace_back(argument, false);
+              }
+            }
+          }
+          else
+          {
+            std::size_t f = write_function_symbol(y.function());
+            write_number(static_cast<std::size_t>(record::appl));
+            write_number(f);
+            for (const atermpp::aterm& argument: y)
+            {
+              write_number(m_terms.index(argument));
+            }
+            m_terms.insert(x);
+            stack.pop_back();
+          }
+        }
+      }
+      write_number(static_cast<std::size_t>(record::output));
+      write_number(m_terms.index(t));
+    }
+
+    void put(std::size_t n)
+    {
+      put(atermpp::aterm_int(n));
+    }
+
+    void flush()
+    {
+      m_stream.flush();
+    }
+};
+
+/// \brief Reads the terms that are written by a term_writer.
+class term_reader
+{
+  protected:
+    fd_streambuf m_buffer;
+    std::istream m_stream;
+    atermpp::vector<atermpp::aterm> m_terms;
+    std::vector<atermpp::function_symbol> m_function_symbols;
+
+    bool read_number(std::size_t& n)
+    {
+      n = 0;
+      std::size_t shift = 0;
+      int c;
+      do
+      {
+        c = m_stream.get();
+        if (c == std::char_traits<char>::eof())
+        {
+          return false;
+        }
+        n |= static_cast<std::size_t>(c & 0x7f) << shift;
+        shift += 7;
+      }
+      while (c & 0x80);
+      return true;
+    }
+
+    std::size_t read_number()
+    {
+      std::size_t n;
+      if (!read_number(n))
+      {
+        throw mcrl2::runtime_error("Unexpected end of a stream of terms.");
+      }
+      return n;
+    }
+
+  public:
+    explicit term_reader(int fd)
+      : m_buffer(fd), m_stream(&m_buffer)
+    {}
+
+    /// \brief Reads the next term, and returns false if the end of the stream has been reached.
+    bool get(atermpp::aterm& t)
+    {
+      std::size_t kind;
+      while (read_number(kind))
+      {
+        switch (static_cast<record>(kind))
+        {
+          case record::function_symbol:
+          {
+            std::string name(read_number(), ' ');
+            m_stream.read(name.data(), name.size());
+            m_function_symbols.emplace_back(name, read_number());
+            break;
+          }
+          case record::integer:
+          {
+            m_terms.emplace_back(atermpp::aterm_int(read_number()));
+            break;
+          }
+          case record::appl:
+          {
+            const atermpp::function_symbol& f = m_function_symbols[read_number()];
+            std::vector<atermpp::aterm> arguments;
+            for (std::size_t i = 0; i < f.arity(); ++i)
+            {
+              arguments.push_back(m_terms[read_number()]);
+            }
+            m_terms.emplace_back(data::detail::add_index_impl(atermpp::aterm_appl(f, arguments.begin(), arguments.end())));
+            break;
+          }
+          case record::output:
+          {
+            t = m_terms[read_number()];
+            return true;
+          }
+          case record::reset:
+          {
+            m_terms.clear();
+            m_function_symbols.clear();
+            break;
+          }
+          default: throw mcrl2::runtime_error("Unknown record in a stream of terms.");
+        }
+      }
+      return false;
+    }
+
+    atermpp::aterm get()
+    {
+      atermpp::aterm t;
+      if (!get(t))
+      {
+        throw mcrl2::runtime_error("Unexpected end of a stream of terms.");
+      }
+      return t;
+    }
+
+    std::size_t get_number()
+    {
+      return atermpp::down_cast<atermpp::aterm_int>(get()).value();
+    }
+};
+
+inline
+atermpp::aterm_appl multi_action_to_term(const lps::multi_action& a)
+{
+  static atermpp::function_symbol f("multi_action", 2);
+  return atermpp::aterm_appl(f, a.actions(), a.time());
+}
+
+inline
+lps::multi_action term_to_multi_action(const atermpp::aterm& t)
+{
+  const atermpp::aterm_appl& a = atermpp::down_cast<atermpp::aterm_appl>(t);
+  return lps::multi_action(atermpp::down_cast<process::action_list>(a[0]), atermpp::down_cast<data::data_expression>(a[1]));
+}
+
+/// \brief Computes a hash of a term that only depends on its structure, such that it is the same in
+///        all processes. Term addresses, and hence std::hash, differ between processes.
+class structural_hash
+{
+  protected:
+    std::unordered_map<atermpp::function_symbol, std::size_t> m_symbol_hashes;
+
+    std::size_t symbol_hash(const atermpp::function_symbol& f)
+    {
+      auto i = m_symbol_hashes.find(f);
+      if (i == m_symbol_hashes.end())
+      {
+        i = m_symbol_hashes.emplace(f, std::hash<std::string>()(f.name()) * 31 + f.arity()).first;
+      }
+      return i->second;
+    }
+
+  public:
+    std::size_t operator()(const atermpp::aterm& t)
+    {
+      if (t.type_is_int())
+      {
+        return atermpp::down_cast<atermpp::aterm_int>(t).value();
+      }
+      const atermpp::aterm_appl& a = atermpp::down_cast<atermpp::aterm_appl>(t);
+      if (a.function() == core::detail::function_symbol_OpId())
+      {
+        // Only the name is used, as the last argument is an index that is specific to this process.
+        return symbol_hash(atermpp::down_cast<atermpp::aterm_appl>(a[0]).function());
+      }
+      std::size_t result = symbol_hash(a.function());
+      for (const atermpp::aterm& argument: a)
+      {
+        result = result * 1000003 ^ (*this)(argument);
+      }
+      return result;
+    }
+};
+
+// Commands that the coordinator sends to the workers.
+enum class command { probe, stop };
+
+/// \brief A worker process. It explores the states that it owns, and sends transitions to states that are
+///        owned by other workers to their owners. The owner of a transition to a state records the transition.
+/// \details State i of worker w has the global number i * N + w, where N is the number of workers.
+template <typename Explorer>
+class worker
+{
+  protected:
+    Explorer& m_explorer;
+    const std::size_t m_index;
+    const std::size_t m_number_of_workers;
+    std::vector<int> m_peer_sockets;
+    std::vector<std::unique_ptr<term_writer>> m_out;
+    std::vector<std::unique_ptr<term_reader>> m_in;
+    term_reader m_control_in;
+    term_writer m_control_out;
+    structural_hash m_hash;
+
+    atermpp::indexed_set<lps::state> m_states;
+    std::deque<std::size_t> m_todo;
+    std::unordered_map<lps::multi_action, std::size_t> m_label_index;
+    std::vector<lps::multi_action> m_labels;
+    std::vector<std::array<std::size_t, 3>> m_transitions;  // (global source, label, local target)
+
+    // The following variables are protected by m_mutex. The inbox contains the received transitions as triples
+    // of terms. It is an atermpp container, as the terms are created by the receiving threads, and terms that are
+    // stored in ordinary variables are only protected against garbage collection in the thread that created them.
+    std::mutex m_mutex;
+    std::condition_variable m_inbox_changed;
+    atermpp::vector<atermpp::aterm> m_inbox;
+    bool m_idle = false;
+    bool m_stop = false;
+    bool m_aborted = false;
+    std::size_t m_sent = 0;
+    std::size_t m_received = 0;
+
+    std::size_t owner(const lps::state& s)
+    {
+      return m_hash(s) % m_number_of_workers;
+    }
+
+    void add_transition(std::size_t source, const lps::multi_action& a, const lps::state& s)
+    {
+      auto [target, is_new] = m_states.insert(s);
+      if (is_new)
+      {
+        m_todo.push_back(target);
+      }
+      auto i = m_label_index.find(a);
+      if (i == m_label_index.end())
+      {
+        i = m_label_index.emplace(a, m_labels.size()).first;
+        m_labels.push_back(a);
+      }
+      m_transitions.push_back({ source, i->second, target });
+    }
+
+    // Stops the exploration because another process has terminated unexpectedly.
+    void abort()
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+      m_aborted = true;
+      m_inbox_changed.notify_one();
+    }
+
+    void receive(std::size_t peer)
+    {
+      try
+      {
+        term_reader& in = *m_in[peer];
+        atermpp::aterm source;
+        while (in.get(source))
+        {
+          const atermpp::aterm label = in.get();
+          const atermpp::aterm target = in.get();
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_inbox.push_back(source);
+          m_inbox.push_back(label);
+          m_inbox.push_back(target);
+          m_idle = false;
+          m_inbox_changed.notify_one();
+        }
+      }
+      catch (const mcrl2::runtime_error&)
+      {
+        abort();
+      }
+    }
+
+    void control()
+    {
+      atermpp::aterm t;
+      while (m_control_in.get(t))
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (static_cast<command>(atermpp::down_cast<atermpp::aterm_int>(t).value()) == command::stop)
+        {
+          m_stop = true;
+          m_inbox_changed.notify_one();
+          return;
+        }
+        std::array<std::size_t, 3> status = { m_idle ? 1u : 0u, m_sent, m_received };
+        lock.unlock();
+        for (std::size_t x: status)
+        {
+          m_control_out.put(x);
+        }
+        m_control_out.flush();
+      }
+      abort();
+    }
+
+    void explore(const lps::state& s0)
+    {
+      if (owner(s0) == m_index)
+      {
+        m_todo.push_back(m_states.insert(s0).first);
+      }
+
+      atermpp::vector<atermpp::aterm> inbox;
+      while (true)
+      {
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          if (m_todo.empty() && m_inbox.empty() && !m_stop)
+          {
+            // The mutex is released while flushing, since the receiving threads of the peers may block on
+            // a full socket until the receiving threads of this worker have obtained the mutex.
+            lock.unlock();
+            for (std::size_t i = 0; i < m_number_of_workers; ++i)
+            {
+              if (i != m_index)
+              {
+                m_out[i]->flush();
+              }
+            }
+            lock.lock();
+            m_idle = m_inbox.empty();
+            m_inbox_changed.wait(lock, [&]() { return !m_inbox.empty() || m_stop; });
+          }
+          if (m_stop)
+          {
+            assert(m_aborted || m_inbox.empty());
+            return;
+          }
+          m_idle = false;
+          inbox.swap(m_inbox);
+        }
+
+        for (std::size_t i = 0; i < inbox.size(); i += 3)
+        {
+          const atermpp::aterm source = inbox[i];
+          const atermpp::aterm label = inbox[i + 1];
+          const atermpp::aterm target = inbox[i + 2];
+          add_transition(atermpp::down_cast<atermpp::aterm_int>(source).value(),
+                         term_to_multi_action(label),
+                         atermpp::down_cast<lps::state>(target));
+        }
+        const std::size_t received = inbox.size() / 3;
+        inbox.clear();
+
+        // Explore a limited number of states, such that incoming messages are processed regularly.
+        std::size_t sent = 0;
+        for (std::size_t k = 0; k < 1000 && !m_todo.empty(); ++k)
+        {
+          const std::size_t i = m_todo.front();
+          m_todo.pop_front();
+          const std::size_t source = i * m_number_of_workers + m_index;
+          for (const auto& [a, s1]: m_explorer.generate_transitions(m_states.at(i)))
+          {
+            const std::size_t w = owner(s1);
+            if (w == m_index)
+            {
+              add_transition(source, a, s1);
+            }
+            else
+            {
+              m_out[w]->put(source);
+              m_out[w]->put(multi_action_to_term(a));
+              m_out[w]->put(s1);
+              sent++;
+            }
+          }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sent += sent;
+        m_received += received;
+      }
+    }
+
+  public:
+    /// \param peer_sockets The sockets connected to the other workers; the element at position index is ignored.
+    /// \param control_socket The socket connected to the coordinator.
+    worker(Explorer& explorer, std::size_t index, const std::vector<int>& peer_sockets, int control_socket)
+      : m_explorer(explorer),
+        m_index(index),
+        m_number_of_workers(peer_sockets.size()),
+        m_peer_sockets(peer_sockets),
+        m_out(peer_sockets.size()),
+        m_in(peer_sockets.size()),
+        m_control_in(control_socket),
+        m_control_out(control_socket)
+    {
+      for (std::size_t i = 0; i < m_number_of_workers; ++i)
+      {
+        if (i != m_index)
+        {
+          m_out[i] = std::make_unique<term_writer>(peer_sockets[i]);
+          m_in[i] = std::make_unique<term_reader>(peer_sockets[i]);
+        }
+      }
+    }
+
+    /// \brief Explores the owned part of the state space from the initial state s0, and sends the partial
+    ///        state space to the coordinator when it sends the stop command.
+    void run(const lps::state& s0)
+    {
+      std::vector<std::thread> receivers;
+      for (std::size_t i = 0; i < m_number_of_workers; ++i)
+      {
+        if (i != m_index)
+        {
+          receivers.emplace_back([this, i]() { receive(i); });
+        }
+      }
+      std::thread controller([this]() { control(); });
+
+      explore(s0);
+
+      // All workers are idle, so no messages are underway. Closing the sockets ends the receiving threads.
+      for (std::size_t i = 0; i < m_number_of_workers; ++i)
+      {
+        if (i != m_index)
+        {
+          m_out[i]->flush();
+          ::shutdown(m_peer_sockets[i], SHUT_WR);
+        }
+      }
+      for (std::thread& t: receivers)
+      {
+        t.join();
+      }
+      controller.join();
+      if (m_aborted)
+      {
+        throw mcrl2::runtime_error("The exploration was aborted, as another process terminated unexpectedly.");
+      }
+
+      m_control_out.put(m_states.size());
+      for (std::size_t i = 0; i < m_states.size(); ++i)
+      {
+        m_control_out.put(m_states.at(i));
+      }
+      m_control_out.put(m_labels.size());
+      for (const lps::multi_action& a: m_labels)
+      {
+        m_control_out.put(multi_action_to_term(a));
+      }
+      m_control_out.put(m_transitions.size());
+      for (const auto& [source, label, target]: m_transitions)
+      {
+        m_control_out.put(source);
+        m_control_out.put(label);
+        m_control_out.put(target);
+      }
+      m_control_out.flush();
+    }
+};
+
+/// \brief Generates the state space of the explorer with the given number of worker processes, and stores it
+///        in the builder.
+/// \details The workers are forked from this process, and are connected by Unix domain sockets. This process
+///          detects termination by repeatedly asking all workers whether they are idle and how many messages they
+///          have sent and received. It stops the workers if two consecutive rounds give the same numbers, all
+///          workers are idle and the number of sent messages equals the number of received messages. Then the
+///          partial state spaces of the workers are merged, such that the initial state gets number 0.
+/// \pre The explorer must be single threaded, and the specification must be neither stochastic nor timed.
+template <typename Explorer>
+void generate_state_space(Explorer& explorer, std::size_t number_of_workers, lts_builder& builder)
+{
+  const std::size_t N = number_of_workers;
+  const lps::state s0 = explorer.compute_initial_state();
+
+  std::vector<std::vector<int>> peer_sockets(N, std::vector<int>(N, -1));
+  std::vector<std::array<int, 2>> control_sockets(N);
+  auto make_socket_pair = [](std::array<int, 2>& result)
+  {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+    {
+      throw mcrl2::runtime_error("Could not create a socket pair: " + std::string(std::strerror(errno)) + ".");
+    }
+    result = { fds[0], fds[1] };
+  };
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    make_socket_pair(control_sockets[i]);
+    for (std::size_t j = i + 1; j < N; ++j)
+    {
+      std::array<int, 2> fds;
+      make_socket_pair(fds);
+      peer_sockets[i][j] = fds[0];
+      peer_sockets[j][i] = fds[1];
+    }
+  }
+
+  std::vector<pid_t> workers;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    pid_t pid = ::fork();
+    if (pid < 0)
+    {
+      throw mcrl2::runtime_error("Could not start a worker process: " + std::string(std::strerror(errno)) + ".");
+    }
+    if (pid == 0)
+    {
+      int status = EXIT_SUCCESS;
+      try
+      {
+        for (std::size_t j = 0; j < N; ++j)
+        {
+          ::close(control_sockets[j][0]);
+          if (j != i)
+          {
+            ::close(control_sockets[j][1]);
+            for (std::size_t k = 0; k < N; ++k)
+            {
+              if (k != j)
+              {
+                ::close(peer_sockets[j][k]);
+              }
+            }
+          }
+        }
+        worker<Explorer> w(explorer, i, peer_sockets[i], control_sockets[i][1]);
+        w.run(s0);
+      }
+      catch (const std::exception& e)
+      {
+        mCRL2log(log::error) << "Worker " << i << ": " << e.what() << std::endl;
+        status = EXIT_FAILURE;
+      }
+      std::_Exit(status);
+    }
+    workers.push_back(pid);
+  }
+
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    ::close(control_sockets[i][1]);
+    for (std::size_t j = 0; j < N; ++j)
+    {
+      if (j != i)
+      {
+        ::close(peer_sockets[i][j]);
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<term_reader>> in;
+  std::vector<std::unique_ptr<term_writer>> out;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    in.push_back(std::make_unique<term_reader>(control_sockets[i][0]));
+    out.push_back(std::make_unique<term_writer>(control_sockets[i][0]));
+  }
+
+  // Termination detection.
+  const std::pair<std::size_t, std::size_t> undefined(std::numeric_limits<std::size_t>::max(), std::numeric_limits<std::size_t>::max());
+  std::pair<std::size_t, std::size_t> previous = undefined;
+  while (true)
+  {
+    bool all_idle = true;
+    std::pair<std::size_t, std::size_t> current(0, 0);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      out[i]->put(static_cast<std::size_t>(command::probe));
+      out[i]->flush();
+    }
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      all_idle = in[i]->get_number() == 1 && all_idle;
+      current.first += in[i]->get_number();
+      current.second += in[i]->get_number();
+    }
+    if (all_idle && current.first == current.second && current == previous)
+    {
+      break;
+    }
+    previous = all_idle ? current : undefined;
+    std::this_thread::sleep_for(std::chrono::milliseconds(all_idle ? 1 : 10));
+  }
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    out[i]->put(static_cast<std::size_t>(command::stop));
+    out[i]->flush();
+  }
+
+  // Merge the partial state spaces. The numbering starts with the worker that owns the initial state.
+  structural_hash hash;
+  const std::size_t first = hash(s0) % N;
+  std::vector<std::size_t> number_of_states(N);
+  std::vector<std::size_t> offset(N);
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    number_of_states[i] = in[i]->get_number();
+  }
+  std::size_t total = 0;
+  for (std::size_t k = 0; k < N; ++k)
+  {
+    const std::size_t i = (first + k) % N;
+    offset[i] = total;
+    total += number_of_states[i];
+    mCRL2log(log::verbose) << "Worker " << i << " explored " << number_of_states[i] << " states." << std::endl;
+  }
+
+  lts_builder::indexed_set_for_states_type state_map;
+  std::size_t number_of_transitions = 0;
+  for (std::size_t k = 0; k < N; ++k)
+  {
+    const std::size_t i = (first + k) % N;
+    for (std::size_t j = 0; j < number_of_states[i]; ++j)
+    {
+      state_map.insert(atermpp::down_cast<lps::state>(in[i]->get()));
+    }
+    std::vector<lps::multi_action> labels(in[i]->get_number());
+    for (lps::multi_action& a: labels)
+    {
+      a = term_to_multi_action(in[i]->get());
+    }
+    const std::size_t m = in[i]->get_number();
+    for (std::size_t j = 0; j < m; ++j)
+    {
+      const std::size_t source = in[i]->get_number();
+      const lps::multi_action& a = labels[in[i]->get_number()];
+      const std::size_t target = in[i]->get_number();
+      builder.add_transition(offset[source % N] + source / N, a, offset[i] + target);
+    }
+    number_of_transitions += m;
+  }
+  builder.finalize(state_map, false);
+
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    ::close(control_sockets[i][0]);
+    int status;
+    if (::waitpid(workers[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+    {
+      throw mcrl2::runtime_error("Worker " + std::to_string(i) + " did not terminate successfully.");
+    }
+  }
+  mCRL2log(log::verbose) << "Done with state space generation (" << state_map.size() << " states and "
+                         << number_of_transitions << " transitions)" << std::endl;
+}
+
+} // namespace mcrl2::lts::distributed
+
+#endif // MCRL2_PLATFORM_WINDOWS
+
+#endif // MCRL2_LPS2LTS_DISTRIBUTED_EXPLORATION_H
@@ -19,6 +19,7 @@
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/stochastic_lts_builder.h"
 #include "mcrl2/lts/state_space_generator.h"
+#include "distributed_exploration.h"
 
 using namespace mcrl2;
 using utilities::tools::input_output_tool;
@@ -33,6 +34,7 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
   lts::lts_type output_format = lts::lts_none;
   lps::abortable* current_explorer = nullptr;
   std::set<std::string> trace_multiaction_strings;
+  std::size_t number_of_processes = 1;
 
   public:
     lps2lts_tool()
@@ -53,6 +55,8 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       desc.add_hidden_option("no-one-point-rule-rewrite", "do not apply the one point rule rewriter");
       desc.add_hidden_option("no-replace-constants-by-variables", "do not move constant expressions to a substitution");
       desc.add_option("no-probability-checking", "do not check if probabilities in stochastic specifications have sensible values");
+      desc.add_hidden_option("no-guard-index", "rewrite the conditions of all summands in every state, instead of skipping "
+                 "the summands of which the condition contains an equality on a parameter that does not hold");
       desc.add_hidden_option("dfs-recursive", "use recursive depth first search for divergence detection");
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
       desc.add_option("todo-max", utilities::make_mandatory_argument("NUM"),
@@ -97,6 +101,23 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
                  "to tau use the flag -ctau. Only if the linear process is tau-confluent, the generated "
                  "state space is branching bisimilar to the state space of the lps. The generation "
                  "algorithm that is used does not require the linear process to be tau convergent. ", 'c');
+      desc.add_option("partial-order-reduction",
+                 "only explore the transitions of a stubborn set of summands in every state. The generated state space "
+                 "contains all deadlocks of the full state space. If --visible-actions, --action or --multiaction is used, "
+                 "it is moreover stuttering equivalent to the full state space with respect to the given actions. "
+                 "This option cannot be combined with --confluence, --divergence or --nondeterminism, and it is not "
+                 "supported for timed or stochastic specifications.");
+      desc.add_option("visible-actions", utilities::make_mandatory_argument("NAMES"),
+                 "preserve the occurrences of the actions in the comma-separated list of action names NAMES "
+                 "up to stuttering when --partial-order-reduction is used.");
+#ifndef MCRL2_PLATFORM_WINDOWS
+      desc.add_option("processes", utilities::make_mandatory_argument("NUM"),
+                 "explore the state space with NUM worker processes, that each own the states with a given hash value "
+                 "and send the transitions to other states to their owners. The partial state spaces are merged at the end. "
+                 "This option cannot be combined with --threads, the options to detect and report states or actions, "
+                 "--max, --partial-order-reduction, and the strategies depth and highway, and it is not supported for "
+                 "timed or stochastic specifications.");
+#endif
       desc.add_option("out", utilities::make_mandatory_argument("FORMAT"), "save the output in the specified FORMAT. ", 'o');
       desc.add_option("tau", utilities::make_mandatory_argument("NAMES"),
                  "consider actions that occur in the comma-separated list of action names "
@@ -110,7 +131,7 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       desc.add_option("suppress","in verbose mode, do not print progress messages indicating the number of visited states and transitions.");
       desc.add_option("save-at-end", "delay saving of the generated LTS until the end. "
                  "This option only applies to .aut and .lts files, which are by default saved on the fly.");
-      desc.add_option("no-info", "do not add state label information to OUTFILE. This option only applies to .lts files.");
+      desc.add_option("no-info", "do not add state label information to OUTFILE. This option only applies to .lts and .clts files.");
     }
 
     static std::list<std::string> split_actions(const std::string& s)
@@ -208,6 +229,7 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       options.remove_unused_rewrite_rules           = !parser.has_option("no-remove-unused-rewrite-rules");
       options.replace_constants_by_variables        = !parser.has_option("no-replace-constants-by-variables");
       options.check_probabilities                   = !parser.has_option("no-probability-checking");
+      options.guard_index                           = !parser.has_option("no-guard-index");
       options.detect_deadlock                       = parser.has_option("deadlock");
       options.detect_nondeterminism                 = parser.has_option("nondeterminism");
       options.detect_divergence                     = parser.has_option("divergence");
@@ -215,6 +237,7 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       options.suppress_progress_messages            = parser.has_option("suppress");
       options.dfs_recursive                         = parser.has_option("dfs-recursive");
       options.discard_lts_state_labels              = parser.has_option("no-info");
+      options.partial_order_reduction               = parser.has_option("partial-order-reduction");
       options.search_strategy = parser.option_argument_as<lps::exploration_strategy>("strategy");
       options.number_of_threads = number_of_threads();
       // highway search
@@ -294,6 +317,47 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
         options.confluence_action = parser.option_argument("confluence");
       }
 
+      if (parser.has_option("visible-actions"))
+      {
+        if (!options.partial_order_reduction)
+        {
+          parser.error("Option --visible-actions requires the option --partial-order-reduction.");
+        }
+        for (const std::string& s: split_actions(parser.option_argument("visible-actions")))
+        {
+          options.visible_actions.insert(core::identifier_string(s));
+        }
+      }
+
+      if (options.partial_order_reduction)
+      {
+        if (options.confluence || options.detect_divergence || options.detect_nondeterminism)
+        {
+          parser.error("Option --partial-order-reduction cannot be combined with --confluence, --divergence or --nondeterminism.");
+        }
+        // The actions that are reported must not be hidden by the reduction.
+        options.visible_actions.insert(options.trace_actions.begin(), options.trace_actions.end());
+      }
+
+      if (parser.has_option("processes"))
+      {
+        number_of_processes = parser.option_argument_as<std::size_t>("processes");
+        if (number_of_processes == 0)
+        {
+          parser.error("The number of processes must be positive.");
+        }
+        if (number_of_processes > 1 &&
+            (options.number_of_threads > 1 || options.detect_deadlock || options.detect_nondeterminism ||
+             options.detect_divergence || options.detect_action || !trace_multiaction_strings.empty() ||
+             options.generate_traces || options.save_error_trace || parser.has_option("max") ||
+             options.partial_order_reduction || options.search_strategy != lps::es_breadth))
+        {
+          parser.error("Option --processes cannot be combined with --threads, --deadlock, --nondeterminism, --divergence, "
+                       "--action, --multiaction, --trace, --error-trace, --max, --partial-order-reduction or a search "
+                       "strategy other than breadth.");
+        }
+      }
+
       if (2 < parser.arguments.size())
       {
         parser.error("Too many file arguments.");
@@ -306,9 +370,9 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
         parser.error("Option '--save-at-end' requires that the output is in .aut or .lts format.");
       }
 
-      if (options.discard_lts_state_labels && (output_filename().empty() || output_format != lts::lts_lts))
+      if (options.discard_lts_state_labels && (output_filename().empty() || (output_format != lts::lts_lts && output_format != lts::lts_clts)))
       {
-        parser.error("Option '--no-info' requires that the output is in .lts format.");
+        parser.error("Option '--no-info' requires that the output is in .lts or .clts format.");
       }
       if (options.number_of_threads>1)
       { 
@@ -354,11 +418,25 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       if (!trace_multiaction_strings.empty())
       {
         parse_trace_multiactions(stochastic_lpsspec.data(), stochastic_lpsspec.action_labels());
+        if (options.partial_order_reduction)
+        {
+          for (const lps::multi_action& m: options.trace_multiactions)
+          {
+            for (const process::action& a: m.actions())
+            {
+              options.visible_actions.insert(a.label().name());
+            }
+          }
+        }
       }
       bool is_timed = stochastic_lpsspec.process().has_time();
 
       if (lps::is_stochastic(stochastic_lpsspec))
       {
+        if (number_of_processes > 1)
+        {
+          throw mcrl2::runtime_error("Option --processes is not supported for stochastic specifications.");
+        }
         auto builder = create_stochastic_lts_builder(stochastic_lpsspec, options, output_format);
         if (is_timed)
         {
@@ -373,6 +451,19 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       {
         lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
         auto builder = create_lts_builder(lpsspec, options, output_format, output_filename());
+#ifndef MCRL2_PLATFORM_WINDOWS
+        if (number_of_processes > 1)
+        {
+          if (is_timed)
+          {
+            throw mcrl2::runtime_error("Option --processes is not supported for timed specifications.");
+          }
+          lps::explorer<false, false, lps::specification> explorer(lpsspec, options);
+          lts::distributed::generate_state_space(explorer, number_of_processes, *builder);
+          builder->save(output_filename());
+          return true;
+        }
+#endif
         if (is_timed)
         {
           generate_state_space<false, true>(lpsspec, *builder);
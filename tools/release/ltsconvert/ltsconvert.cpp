@@ -12,8 +12,11 @@
 #define AUTHOR "Muck van Weerdenburg, Jan Friso Groote"
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/lts_algorithm.h"
+#include "mcrl2/lts/lts_clts.h"
+#include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
 
 using namespace mcrl2::lts;
 using namespace mcrl2::lts::detail;
@@ -134,14 +137,15 @@ class t_tool_options
 
 };
 
-class ltsconvert_tool : public input_output_tool
+typedef parallel_tool<input_output_tool> ltsconvert_base;
+class ltsconvert_tool : public ltsconvert_base
 {
   private:
     t_tool_options tool_options;
 
   public:
     ltsconvert_tool() :
-      input_output_tool(NAME,AUTHOR,
+      ltsconvert_base(NAME,AUTHOR,
                       "convert and optionally minimise an LTS",
                       "Convert the labelled transition system (LTS) from INFILE to OUTFILE in the\n"
                       "requested format after applying the selected minimisation method (default is\n"
@@ -191,7 +195,7 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(verbose) << "Reducing LTS (modulo " <<  description(tool_options.equivalence) << ")..." << std::endl;
           mCRL2log(verbose) << "Before reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
           timer().start("reduction");
-          reduce(l,tool_options.equivalence);
+          reduce(l,tool_options.equivalence,number_of_threads());
           timer().finish("reduction");
           mCRL2log(verbose) << "After reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
         }
@@ -276,6 +280,23 @@ class ltsconvert_tool : public input_output_tool
           l_out.save(tool_options.outfilename);
           return true;
         }
+        case lts_clts:
+        {
+          lts_lts_t l_out;
+          if constexpr (LTS_TYPE::is_probabilistic_lts)
+          {
+            // The .clts format only contains plain transition systems, which fails if l is actually probabilistic.
+            probabilistic_lts_lts_t l_probabilistic;
+            lts_convert(l,l_probabilistic,spec.data(),spec.action_labels(),spec.process().process_parameters(),!tool_options.lpsfile.empty());
+            swap_to_non_probabilistic_lts(l_probabilistic, l_out);
+          }
+          else
+          {
+            lts_convert(l,l_out,spec.data(),spec.action_labels(),spec.process().process_parameters(),!tool_options.lpsfile.empty());
+          }
+          save_clts(l_out, tool_options.outfilename);
+          return true;
+        }
       }
       return true;
     }
@@ -286,6 +307,7 @@ class ltsconvert_tool : public input_output_tool
       switch (tool_options.intype)
       {
         case lts_lts:
+        case lts_clts:
         {
           return load_convert_and_save<lts_lts_t>();
         }
@@ -321,7 +343,7 @@ class ltsconvert_tool : public input_output_tool
   protected:
     void add_options(interface_description& desc)
     {
-      input_output_tool::add_options(desc);
+      ltsconvert_base::add_options(desc);
 
       desc.add_option("no-reach",
                       "do not perform a reachability check on the input LTS.");
@@ -346,10 +368,12 @@ class ltsconvert_tool : public input_output_tool
                       .add_value(lts_eq_branching_bisim_gv)
                       .add_value(lts_eq_branching_bisim_gjkw)
                       .add_value(lts_eq_branching_bisim_sigref)
+                      .add_value(lts_eq_branching_bisim_par)
                       .add_value(lts_eq_divergence_preserving_branching_bisim)
                       .add_value(lts_eq_divergence_preserving_branching_bisim_gv)
                       .add_value(lts_eq_divergence_preserving_branching_bisim_gjkw)
                       .add_value(lts_eq_divergence_preserving_branching_bisim_sigref)
+                      .add_value(lts_eq_divergence_preserving_branching_bisim_par)
                       .add_value(lts_eq_weak_bisim)
                       .add_value(lts_eq_divergence_preserving_weak_bisim)
                       .add_value(lts_eq_sim)
@@ -378,7 +402,7 @@ class ltsconvert_tool : public input_output_tool
 
     void parse_options(const command_line_parser& parser)
     {
-      input_output_tool::parse_options(parser);
+      ltsconvert_base::parse_options(parser);
 
       if (parser.options.count("lps"))
       {
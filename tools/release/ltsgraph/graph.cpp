@@ -145,6 +145,7 @@ void Graph::load(const QString& filename, const QVector3D& min,
       templatedLoad<mcrl2::lts::probabilistic_lts_fsm_t>(filename, min, max);
       break;
     case mcrl2::lts::lts_lts:
+    case mcrl2::lts::lts_clts:
     default:
       m_type = mcrl2::lts::lts_lts;
       templatedLoad<mcrl2::lts::probabilistic_lts_lts_t>(filename, min, max);
@@ -319,6 +319,7 @@ class ltsinfo_tool : public ltsinfo_base
       {
         case lts_lts:
         case lts_lts_probabilistic:
+        case lts_clts:
         {
           return provide_information<probabilistic_lts_lts_t>();
         }
@@ -207,6 +207,10 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(warning) << "Probabilistic bisimulation on a .dot file has not been implemented.";
           break;
         }
+        case lts_clts:
+        {
+          throw mcrl2::runtime_error("The .clts format cannot contain a probabilistic transition system.");
+        }
 
       }
    
@@ -233,6 +237,7 @@ class ltsconvert_tool : public input_output_tool
         }
         case lts_lts:
         case lts_lts_probabilistic:
+        case lts_clts:
         {
           load_convert_and_save<probabilistic_lts_lts_t>();
           break;
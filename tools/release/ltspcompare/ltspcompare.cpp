@@ -165,6 +165,7 @@ class ltspcompare_tool : public ltscompare_base
       switch (tool_options.format_for_first)
       {
         case lts_lts:
+        case lts_clts:
         {
           return lts_probabilistic_compare<probabilistic_lts_lts_t>();
         }